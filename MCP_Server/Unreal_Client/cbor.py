@@ -0,0 +1,159 @@
+"""
+Minimal CBOR (RFC 8949) codec for the Unreal protocol.
+
+Covers the JSON data model the plugin uses: maps with string keys, arrays, text strings,
+integers, floats, booleans and null. Definite and indefinite lengths are both decoded.
+Used when the optional cbor2 package (which has a C accelerator) is not installed.
+"""
+import struct
+from typing import Any, Tuple
+
+
+class CBORDecodeError(ValueError):
+    """Malformed or unsupported CBOR input."""
+
+
+_BREAK = object()
+_HALF = struct.Struct('>e')
+_FLOAT = struct.Struct('>f')
+_DOUBLE = struct.Struct('>d')
+
+
+def _encode_head(major: int, value: int, out: bytearray):
+    if value < 24:
+        out.append((major << 5) | value)
+    elif value < 0x100:
+        out.append((major << 5) | 24)
+        out.append(value)
+    elif value < 0x10000:
+        out.append((major << 5) | 25)
+        out += value.to_bytes(2, 'big')
+    elif value < 0x100000000:
+        out.append((major << 5) | 26)
+        out += value.to_bytes(4, 'big')
+    else:
+        out.append((major << 5) | 27)
+        out += value.to_bytes(8, 'big')
+
+
+def _encode(value: Any, out: bytearray):
+    if value is None:
+        out.append(0xF6)
+    elif value is True:
+        out.append(0xF5)
+    elif value is False:
+        out.append(0xF4)
+    elif isinstance(value, int):
+        if value >= 0:
+            _encode_head(0, value, out)
+        else:
+            _encode_head(1, -1 - value, out)
+    elif isinstance(value, float):
+        out.append(0xFB)
+        out += _DOUBLE.pack(value)
+    elif isinstance(value, str):
+        encoded = value.encode('utf-8')
+        _encode_head(3, len(encoded), out)
+        out += encoded
+    elif isinstance(value, (bytes, bytearray)):
+        _encode_head(2, len(value), out)
+        out += value
+    elif isinstance(value, (list, tuple)):
+        _encode_head(4, len(value), out)
+        for item in value:
+            _encode(item, out)
+    elif isinstance(value, dict):
+        _encode_head(5, len(value), out)
+        for key, item in value.items():
+            _encode(str(key), out)
+            _encode(item, out)
+    else:
+        raise TypeError(f"Cannot CBOR-encode {type(value).__name__}")
+
+
+def dumps(value: Any) -> bytes:
+    out = bytearray()
+    _encode(value, out)
+    return bytes(out)
+
+
+def _decode(data, offset: int) -> Tuple[Any, int]:
+    initial = data[offset]
+    offset += 1
+    major, info = initial >> 5, initial & 0x1F
+
+    if major == 7:
+        if info == 20:
+            return False, offset
+        if info == 21:
+            return True, offset
+        if info in (22, 23):
+            return None, offset
+        if info == 25:
+            return _HALF.unpack_from(data, offset)[0], offset + 2
+        if info == 26:
+            return _FLOAT.unpack_from(data, offset)[0], offset + 4
+        if info == 27:
+            return _DOUBLE.unpack_from(data, offset)[0], offset + 8
+        if info == 31:
+            return _BREAK, offset
+        raise ValueError(f"Unsupported CBOR simple value {info}")
+
+    if info < 24:
+        length = info
+    elif info == 31:
+        length = None
+    elif info <= 27:
+        size = 1 << (info - 24)
+        length = int.from_bytes(data[offset:offset + size], 'big')
+        offset += size
+    else:
+        raise ValueError(f"Invalid CBOR additional info {info}")
+
+    if major == 0:
+        return length, offset
+    if major == 1:
+        return -1 - length, offset
+    if major in (2, 3):
+        if length is None:
+            chunks = []
+            while data[offset] != 0xFF:
+                chunk, offset = _decode(data, offset)
+                chunks.append(chunk)
+            joined = b''.join(chunk if isinstance(chunk, bytes) else chunk.encode('utf-8') for chunk in chunks)
+            return (joined.decode('utf-8') if major == 3 else joined), offset + 1
+        raw = bytes(data[offset:offset + length])
+        return (raw.decode('utf-8') if major == 3 else raw), offset + length
+    if major == 4:
+        items = []
+        if length is None:
+            while True:
+                item, offset = _decode(data, offset)
+                if item is _BREAK:
+                    return items, offset
+                items.append(item)
+        for _ in range(length):
+            item, offset = _decode(data, offset)
+            items.append(item)
+        return items, offset
+    if major == 5:
+        result = {}
+        remaining = length
+        while remaining is None or remaining > 0:
+            key, offset = _decode(data, offset)
+            if key is _BREAK:
+                break
+            result[key], offset = _decode(data, offset)
+            if remaining is not None:
+                remaining -= 1
+        return result, offset
+    # Tags carry no meaning in this protocol - return the tagged value
+    return _decode(data, offset)
+
+
+def loads(data) -> Any:
+    try:
+        value, _ = _decode(data, 0)
+    except (IndexError, ValueError, struct.error) as e:
+        raise CBORDecodeError(str(e)) from e
+    return value
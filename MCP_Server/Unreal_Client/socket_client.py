@@ -1,17 +1,33 @@
 """
-Socket Client - TCP communication with Unreal Engine plugin.
+Socket Client - TCP / Unix domain socket communication with Unreal Engine plugin.
 
-Singleton client with automatic retry logic for transient connection errors.
+Singleton client backed by a small pool of persistent connections.
+Requests are tagged with ids so a connection can be reused safely;
+dead connections are detected and replaced transparently.
 """
+import os
 import socket
+import select
+import struct
 import json
+import zlib
 import time
-from typing import Dict, Any, Optional
-from config import UNREAL_HOST, UNREAL_PORT, SOCKET_TIMEOUT
+import uuid
+import itertools
+import threading
+from typing import Dict, Any, Optional, List, Tuple, Iterator
+from config import (
+    UNREAL_HOST, UNREAL_PORT, SOCKET_TIMEOUT,
+    UNREAL_POOL_SIZE, UNREAL_IDLE_CHECK_SECONDS, UNREAL_FRAMING,
+    UNREAL_COMPRESSION, UNREAL_COMPRESSION_THRESHOLD, UNREAL_ENCODING,
+    UNREAL_TRANSPORT, UNREAL_SOCKET_PATH
+)
 from ..utils import log_error, log_warning, log_mcp_call, create_error_response
 
 MAX_RETRIES = 3
 RETRY_DELAY = 0.5
+JOB_POLL_INTERVAL = 0.25
+JOB_FINAL_STATES = ("succeeded", "failed", "cancelled")
 RETRYABLE_ERRORS = (
     ConnectionResetError,
     ConnectionAbortedError,
@@ -19,9 +35,297 @@ RETRYABLE_ERRORS = (
     OSError,
 )
 
+RECV_BUFFER_SIZE = 65536
+# The plugin's per-connection limit; negotiate reports the actual value
+DEFAULT_MAX_IN_FLIGHT = 32
+LENGTH_PREFIX = struct.Struct('>I')
+# High bit of the length prefix marks a compressed frame: <uncompressed size><codec output>
+COMPRESSED_FLAG = 0x80000000
+
+try:
+    import lz4.block as _lz4_block
+except ImportError:
+    _lz4_block = None
+
+# cbor2 decodes in C; the bundled codec covers the same data model when it is not installed
+try:
+    import cbor2 as _cbor
+except ImportError:
+    from . import cbor as _cbor
+
+DECODE_ERRORS = (json.JSONDecodeError, _cbor.CBORDecodeError)
+
+DECOMPRESSORS = {"zlib": lambda data, size: zlib.decompress(data)}
+if _lz4_block is not None:
+    DECOMPRESSORS["lz4"] = lambda data, size: _lz4_block.decompress(data, uncompressed_size=size)
+
+
+LOCAL_HOSTS = ("127.0.0.1", "localhost", "::1")
+
+
+def default_socket_path(port: int) -> str:
+    """Where the plugin's local listener lives for a given TCP port."""
+    return f"/tmp/unreal-mcp-{port}.sock"
+
+
+def supported_compression(requested: str) -> List[str]:
+    """Codecs from a comma-separated preference list that this client can decode."""
+    names = [name.strip().lower() for name in requested.split(",")]
+    return [name for name in names if name in DECOMPRESSORS]
+
+
+class UnrealConnection:
+    """One persistent socket to the plugin with its own receive buffer.
+
+    On connect the wire framing is negotiated: length-prefixed frames when the
+    plugin supports them, newline-delimited JSON otherwise.
+
+    transport "auto" prefers the plugin's Unix domain socket when the editor runs
+    on this machine and the socket file exists, falling back to TCP; "unix" and
+    "tcp" force one or the other.
+    """
+
+    def __init__(
+        self,
+        host: str,
+        port: int,
+        timeout: float,
+        framing: str = "newline",
+        compression: Optional[List[str]] = None,
+        compression_threshold: int = 16384,
+        encoding: str = "json",
+        transport: str = "auto",
+        socket_path: Optional[str] = None,
+    ):
+        self.host = host
+        self.port = port
+        self.requested_transport = transport
+        self.socket_path = socket_path or default_socket_path(port)
+        self.transport = "tcp"
+        self.timeout = timeout
+        self.requested_framing = framing
+        self.requested_compression = compression or []
+        self.compression_threshold = compression_threshold
+        self.requested_encoding = encoding
+        self.framing = "newline"
+        self.encoding = "json"
+        self.compression = "none"
+        self.max_in_flight = DEFAULT_MAX_IN_FLIGHT
+        self._socket: Optional[socket.socket] = None
+        # Bytes [_recv_start, _recv_end) are unread; received into directly with recv_into
+        self._recv_buffer = bytearray(RECV_BUFFER_SIZE)
+        self._recv_start = 0
+        self._recv_end = 0
+        self._scan_offset = 0
+        self.last_used = 0.0
+
+    def _use_local_socket(self) -> bool:
+        if self.requested_transport == "tcp" or not hasattr(socket, "AF_UNIX"):
+            return False
+        if self.requested_transport == "unix":
+            return True
+        return self.host in LOCAL_HOSTS and os.path.exists(self.socket_path)
+
+    def _connect_unix(self) -> socket.socket:
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            sock.settimeout(self.timeout)
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
+            sock.connect(self.socket_path)
+        except Exception:
+            sock.close()
+            raise
+        return sock
+
+    def _connect_tcp(self) -> socket.socket:
+        sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        try:
+            sock.settimeout(self.timeout)
+            sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
+            sock.connect((self.host, self.port))
+        except Exception:
+            sock.close()
+            raise
+        return sock
+
+    def connect(self):
+        """Open the socket and negotiate framing. Raises on failure."""
+        self.close()
+        sock = None
+        if self._use_local_socket():
+            try:
+                sock = self._connect_unix()
+                self.transport = "unix"
+            except OSError as e:
+                if self.requested_transport == "unix":
+                    raise
+                # Stale socket file from an editor that exited - TCP still works
+                log_warning(f"Local socket {self.socket_path} unavailable, using TCP: {e}")
+        if sock is None:
+            sock = self._connect_tcp()
+            self.transport = "tcp"
+        self._socket = sock
+        self.last_used = time.monotonic()
+
+        if self.requested_framing != "newline":
+            self._negotiate()
+
+    def _negotiate(self):
+        params = {"framing": self.requested_framing, "encoding": self.requested_encoding}
+        if self.requested_compression:
+            params["compression"] = self.requested_compression
+            params["compression_threshold"] = self.compression_threshold
+
+        response = self.request(0, "negotiate", params)
+        if response.get("status") == "success":
+            result = response.get("result", {})
+            self.framing = result.get("framing", "newline")
+            self.encoding = result.get("encoding", "json")
+            self.compression = result.get("compression", "none")
+            self.max_in_flight = max(1, int(result.get("max_in_flight", DEFAULT_MAX_IN_FLIGHT)))
+        else:
+            # Older plugin builds answer "Unknown command" - stay on newline framing
+            log_warning(f"Framing negotiation declined, using newline: {response.get('error')}")
+
+    @property
+    def is_open(self) -> bool:
+        return self._socket is not None
+
+    def close(self):
+        if self._socket:
+            try:
+                self._socket.close()
+            except Exception:
+                pass
+            self._socket = None
+        self.framing = "newline"
+        self.encoding = "json"
+        self.compression = "none"
+        self.max_in_flight = DEFAULT_MAX_IN_FLIGHT
+        self._recv_start = self._recv_end = self._scan_offset = 0
+
+    def is_healthy(self) -> bool:
+        """Cheap liveness check: an idle socket that is readable has been closed (or carries stale data)."""
+        if self._socket is None:
+            return False
+        try:
+            readable, _, errored = select.select([self._socket], [], [self._socket], 0)
+        except (OSError, ValueError):
+            return False
+        return not readable and not errored
+
+    def send_all(self, payload: bytes):
+        self._socket.sendall(payload)
+        self.last_used = time.monotonic()
+
+    def encode_message(self, message: Dict[str, Any]) -> bytes:
+        """Serialize one message in the connection's framing and encoding."""
+        payload = _cbor.dumps(message) if self.encoding == "cbor" else json.dumps(message).encode('utf-8')
+        if self.framing == "length_prefixed":
+            return LENGTH_PREFIX.pack(len(payload)) + payload
+        return payload + b'\n'
+
+    def send_message(self, message: Dict[str, Any]):
+        self.send_all(self.encode_message(message))
+
+    def _fill(self):
+        """Receive more bytes into the buffer tail, sliding or growing it when full."""
+        if self._recv_end == len(self._recv_buffer):
+            unread = self._recv_end - self._recv_start
+            if self._recv_start > 0:
+                self._recv_buffer[:unread] = self._recv_buffer[self._recv_start:self._recv_end]
+                self._recv_start, self._recv_end = 0, unread
+            if self._recv_end == len(self._recv_buffer):
+                self._recv_buffer.extend(bytes(len(self._recv_buffer)))
+
+        with memoryview(self._recv_buffer) as view:
+            received = self._socket.recv_into(view[self._recv_end:])
+        if not received:
+            raise ConnectionResetError("Connection closed before receiving data")
+        self._recv_end += received
+
+    def _consume(self, count: int):
+        self._recv_start += count
+        self._scan_offset = 0
+        if self._recv_start == self._recv_end:
+            self._recv_start = self._recv_end = 0
+
+    def receive_message(self) -> Dict[str, Any]:
+        """Receive and decode one framed message."""
+        if self.framing == "length_prefixed":
+            while self._recv_end - self._recv_start < LENGTH_PREFIX.size:
+                self._fill()
+            (length,) = LENGTH_PREFIX.unpack_from(self._recv_buffer, self._recv_start)
+            compressed = bool(length & COMPRESSED_FLAG)
+            length &= ~COMPRESSED_FLAG
+            frame_size = LENGTH_PREFIX.size + length
+            while self._recv_end - self._recv_start < frame_size:
+                self._fill()
+            payload_offset = LENGTH_PREFIX.size
+        else:
+            while True:
+                index = self._recv_buffer.find(b'\n', self._recv_start + self._scan_offset, self._recv_end)
+                if index >= 0:
+                    break
+                self._scan_offset = self._recv_end - self._recv_start
+                self._fill()
+            length = index - self._recv_start
+            frame_size = length + 1
+            payload_offset = 0
+            compressed = False
+
+        # Decode straight from the buffer; the frame is copied once into the bytes json needs
+        payload_start = self._recv_start + payload_offset
+        with memoryview(self._recv_buffer) as view:
+            payload = view[payload_start:payload_start + length]
+            if compressed:
+                (raw_size,) = LENGTH_PREFIX.unpack_from(payload)
+                data = DECOMPRESSORS[self.compression](payload[LENGTH_PREFIX.size:], raw_size)
+            else:
+                data = payload.tobytes()
+            payload.release()
+        message = _cbor.loads(data) if self.encoding == "cbor" else json.loads(data)
+        self._consume(frame_size)
+        self.last_used = time.monotonic()
+        return message
+
+    def request(
+        self,
+        request_id: int,
+        command_type: str,
+        params: Dict[str, Any],
+        idempotency_key: Optional[str] = None
+    ) -> Dict[str, Any]:
+        """Send one tagged command and wait for its tagged response.
+
+        The deadline matches the socket timeout, so the server drops the command instead of
+        running it after this client has given up. A request resent with the same
+        idempotency_key gets the first execution's response instead of running again.
+        """
+        message = {
+            "id": request_id,
+            "type": command_type,
+            "params": params,
+            "deadline_ms": int(self.timeout * 1000),
+        }
+        if idempotency_key:
+            message["idempotency_key"] = idempotency_key
+        self.send_message(message)
+
+        while True:
+            response = self.receive_message()
+            response_id = response.pop("id", None)
+            if response_id == request_id or response_id is None:
+                return response
+            log_warning(f"Discarding stale response for request {response_id}")
+
 
 class UnrealSocketClient:
-    """TCP socket client for Unreal Engine communication with retry logic."""
+    """TCP socket client for Unreal Engine with pooled persistent connections and retry logic."""
     _instance = None
 
     def __new__(cls):
@@ -36,92 +340,300 @@ class UnrealSocketClient:
         self.host = UNREAL_HOST
         self.port = UNREAL_PORT
         self.timeout = float(SOCKET_TIMEOUT)
-        self._socket: Optional[socket.socket] = None
+        self.pool_size = max(1, UNREAL_POOL_SIZE)
+        self.idle_check_seconds = float(UNREAL_IDLE_CHECK_SECONDS)
+        self.framing = UNREAL_FRAMING
+        self.compression = supported_compression(UNREAL_COMPRESSION)
+        self.compression_threshold = UNREAL_COMPRESSION_THRESHOLD
+        self.encoding = UNREAL_ENCODING
+        self.transport = UNREAL_TRANSPORT
+        self.socket_path = UNREAL_SOCKET_PATH or default_socket_path(self.port)
+        self._idle: List[UnrealConnection] = []
+        self._pool_lock = threading.Lock()
+        self._request_ids = itertools.count(1)
+        self._stats = {"connects": 0, "reuses": 0, "discarded": 0}
         self._initialized = True
 
-    def _connect(self) -> bool:
-        """Establish connection to Unreal Engine."""
-        try:
-            self._close_socket()
-            self._socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-            self._socket.settimeout(self.timeout)
-            self._socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
-            self._socket.setsockopt(socket.SOL_SOCKET, socket.SO_KEEPALIVE, 1)
-            self._socket.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 65536)
-            self._socket.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
-            self._socket.connect((self.host, self.port))
-            return True
-        except ConnectionRefusedError as e:
-            log_error(f"Cannot connect to {self.host}:{self.port}", error=e)
-            self._socket = None
-            return False
-        except Exception as e:
-            log_error("Connection failed", error=e)
-            self._socket = None
-            return False
-
-    def _close_socket(self):
-        if self._socket:
-            try:
-                self._socket.close()
-            except Exception:
-                pass
-            self._socket = None
-
-    def close(self):
-        self._close_socket()
-
-    def _receive_full_response(self) -> bytes:
-        """Receive complete JSON response."""
-        chunks = []
-        self._socket.settimeout(self.timeout)
+    # ------------------------------------------------------------------
+    # Pool management
+    # ------------------------------------------------------------------
 
+    def _acquire(self) -> UnrealConnection:
+        """Take an idle healthy connection, or open a new one."""
         while True:
-            chunk = self._socket.recv(65536)
-            if not chunk:
-                if not chunks:
-                    raise ConnectionResetError("Connection closed before receiving data")
-                break
+            with self._pool_lock:
+                connection = self._idle.pop() if self._idle else None
 
-            chunks.append(chunk)
-            data = b''.join(chunks)
+            if connection is None:
+                break
 
-            try:
-                json.loads(data.decode('utf-8'))
-                return data
-            except json.JSONDecodeError:
+            if not connection.is_healthy():
+                self._discard(connection)
                 continue
 
-        return b''.join(chunks)
+            # Long-idle connections get a real round trip before carrying a command
+            if time.monotonic() - connection.last_used > self.idle_check_seconds:
+                try:
+                    response = connection.request(next(self._request_ids), "ping", {})
+                    if response.get("status") != "success":
+                        raise ConnectionResetError("Health check failed")
+                except (*DECODE_ERRORS, socket.timeout, *RETRYABLE_ERRORS):
+                    self._discard(connection)
+                    continue
+
+            self._stats["reuses"] += 1
+            return connection
+
+        connection = UnrealConnection(
+            self.host, self.port, self.timeout, self.framing,
+            self.compression, self.compression_threshold, self.encoding,
+            self.transport, self.socket_path
+        )
+        connection.connect()
+        self._stats["connects"] += 1
+        return connection
+
+    def _release(self, connection: UnrealConnection):
+        """Return a connection to the pool (closed if the pool is full)."""
+        if not connection.is_open:
+            return
+        with self._pool_lock:
+            if len(self._idle) < self.pool_size:
+                self._idle.append(connection)
+                return
+        connection.close()
 
-    def _send_command_once(self, command_type: str, params: Dict[str, Any]) -> Optional[Dict[str, Any]]:
-        """Single attempt to send command."""
-        self._close_socket()
+    def _discard(self, connection: UnrealConnection):
+        self._stats["discarded"] += 1
+        connection.close()
 
-        if not self._connect():
+    def close(self):
+        """Close every pooled connection."""
+        with self._pool_lock:
+            idle, self._idle = self._idle, []
+        for connection in idle:
+            connection.close()
+
+    def get_pool_stats(self) -> Dict[str, Any]:
+        with self._pool_lock:
+            idle = len(self._idle)
+        return {"idle": idle, "pool_size": self.pool_size, **self._stats}
+
+    # ------------------------------------------------------------------
+    # Commands
+    # ------------------------------------------------------------------
+
+    def _send_command_once(
+        self, command_type: str, params: Dict[str, Any], idempotency_key: Optional[str] = None
+    ) -> Optional[Dict[str, Any]]:
+        """Single attempt to send command on a pooled connection."""
+        try:
+            connection = self._acquire()
+        except ConnectionRefusedError as e:
+            log_error(f"Cannot connect to {self.host}:{self.port}", error=e)
             return {"status": "error", "error": "Failed to connect to Unreal Engine"}
 
-        command = {"type": command_type, "params": params}
+        try:
+            response = connection.request(next(self._request_ids), command_type, params, idempotency_key)
+        except BaseException:
+            # Connection state is unknown (partial read, outstanding request) - never reuse it
+            self._discard(connection)
+            raise
+
+        self._release(connection)
+        return response
+
+    def _send_pipelined_once(
+        self, commands: List[Tuple[str, Dict[str, Any]]]
+    ) -> List[Dict[str, Any]]:
+        """Single attempt to send many id-tagged commands over one pooled connection."""
+        try:
+            connection = self._acquire()
+        except ConnectionRefusedError as e:
+            log_error(f"Cannot connect to {self.host}:{self.port}", error=e)
+            return [{"status": "error", "error": "Failed to connect to Unreal Engine"} for _ in commands]
+
+        ids = [next(self._request_ids) for _ in commands]
+        id_set = set(ids)
+
+        def encode(index: int) -> bytes:
+            command_type, params = commands[index]
+            return connection.encode_message({"id": ids[index], "type": command_type, "params": params})
+
+        try:
+            # The plugin stops reading past max_in_flight outstanding requests and drops a client
+            # that does not read its responses, so never have more than that in flight
+            window = min(connection.max_in_flight, len(ids))
+            connection.send_all(b''.join(encode(index) for index in range(window)))
+            next_index = window
+
+            # Responses arrive in completion order, matched back by id
+            responses: Dict[int, Dict[str, Any]] = {}
+            while len(responses) < len(ids):
+                response = connection.receive_message()
+                request_id = response.pop("id", None)
+                if request_id in id_set:
+                    if request_id not in responses and next_index < len(ids):
+                        connection.send_all(encode(next_index))
+                        next_index += 1
+                    responses[request_id] = response
+                elif request_id is None:
+                    # Untagged error (e.g. connection dropped by server) applies to all outstanding
+                    for pending_id in ids:
+                        responses.setdefault(pending_id, response)
+        except BaseException:
+            self._discard(connection)
+            raise
+
+        self._release(connection)
+        return [responses[request_id] for request_id in ids]
+
+    def send_pipelined(
+        self, commands: List[Tuple[str, Dict[str, Any]]]
+    ) -> List[Dict[str, Any]]:
+        """Send many commands back-to-back without waiting for each response.
+
+        Returns responses in the same order as `commands`. Each command is a
+        (command_type, params) tuple.
+        """
+        if not commands:
+            return []
 
         try:
-            command_json = json.dumps(command) + "\n"
-            self._socket.sendall(command_json.encode('utf-8'))
+            return self._send_pipelined_once(commands)
+        except DECODE_ERRORS as e:
+            log_error("Pipelined response decode failed", error=e)
+            return [{"status": "error", "error": "Invalid response format from Unreal Engine"} for _ in commands]
+        except socket.timeout as e:
+            log_error(f"Pipelined commands timed out after {self.timeout}s", error=e)
+            return [{"status": "error", "error": f"Command timed out after {self.timeout}s"} for _ in commands]
+        except RETRYABLE_ERRORS as e:
+            log_error("Pipelined commands failed", error=e)
+            return [{"status": "error", "error": str(e)} for _ in commands]
+
+    def send_batch(
+        self,
+        commands: List[Tuple[str, Dict[str, Any]]],
+        stop_on_error: bool = False,
+        transaction: bool = False,
+    ) -> Dict[str, Any]:
+        """Run many commands in one round trip and one editor tick.
+
+        The response result holds a "results" list with one entry per command,
+        in order: its own status/result/error plus "index", "type" and
+        "elapsed_ms". With stop_on_error, commands after the first failure are
+        reported as "skipped" without running. Params may reference earlier
+        results as "$stepN.field" (see the execute_batch tool). With
+        transaction, the first failure undoes the whole batch in the editor
+        and blueprint compilation waits until every command has succeeded.
+        """
+        params = {
+            "commands": [{"type": command_type, "params": params} for command_type, params in commands],
+            "stop_on_error": stop_on_error,
+            "transaction": transaction,
+        }
+        return self.execute_command("batch", params)
+
+    def stream_command(self, command_type: str, params: Dict[str, Any]) -> Iterator[Dict[str, Any]]:
+        """Run a command in streaming mode, yielding frames as they arrive.
+
+        Frames with status "partial" carry an "items" list for the result field
+        named in "field"; the last frame is the normal final response with a
+        "stream" summary. Supported by list_level_actors, search_actors and
+        analyze_blueprint - other commands just yield their final response.
+        Closing the generator early cancels the command on the server.
+        """
+        connection = self._acquire()
+        request_id = next(self._request_ids)
+        finished = False
+        reusable = True
+
+        try:
+            connection.send_message(
+                {"id": request_id, "type": command_type, "params": params, "stream": True}
+            )
+            while not finished:
+                frame = connection.receive_message()
+                frame_id = frame.pop("id", None)
+                if frame_id not in (request_id, None):
+                    continue
+                finished = frame.get("status") != "partial"
+                yield frame
+        except GeneratorExit:
+            raise
+        except BaseException:
+            reusable = False
+            raise
+        finally:
+            if not finished and reusable:
+                reusable = self._cancel_stream(connection, request_id)
+            if reusable:
+                self._release(connection)
+            else:
+                self._discard(connection)
+
+    def _cancel_stream(self, connection: UnrealConnection, request_id: int) -> bool:
+        """Cancel an unfinished stream and drain it so the connection can be reused."""
+        cancel_id = next(self._request_ids)
+        try:
+            connection.send_message({"id": cancel_id, "type": "cancel", "params": {"id": request_id}})
+            pending = {request_id, cancel_id}
+            while pending:
+                frame = connection.receive_message()
+                frame_id = frame.get("id")
+                if frame_id == cancel_id or (frame_id == request_id and frame.get("status") != "partial"):
+                    pending.discard(frame_id)
+            return True
+        except (*DECODE_ERRORS, socket.timeout, *RETRYABLE_ERRORS):
+            return False
 
-            response_data = self._receive_full_response()
-            response_str = response_data.decode('utf-8').strip()
-            return json.loads(response_str)
+    def subscribe(self, topics: Optional[List[str]] = None) -> Iterator[Dict[str, Any]]:
+        """Yield editor change events as the editor pushes them, instead of re-scanning.
+
+        Topics are "actors", "assets" and "blueprints" (all by default). Events are
+        coalesced per editor tick: actor_added/removed/renamed/moved (by "name"),
+        asset_added/removed/renamed (by "path") and blueprint_compiled. When the editor
+        had to drop events from a frame, a {"type": "resync"} item is yielded and any
+        local mirror should be rebuilt with a full scan. Blocks between events; the
+        subscription uses its own connection and ends when the generator is closed.
+        """
+        connection = self._acquire()
+        subscribe_id = next(self._request_ids)
+
+        try:
+            response = connection.request(subscribe_id, "subscribe", {"topics": topics} if topics else {})
+            if response.get("status") != "success":
+                raise ConnectionError(response.get("error", "subscribe failed"))
+
+            while True:
+                try:
+                    frame = connection.receive_message()
+                except socket.timeout:
+                    # Quiet editor - keep waiting, a partially received frame stays buffered
+                    continue
+                if frame.get("id") != subscribe_id or frame.get("status") != "event":
+                    continue
+                yield from frame.get("events", [])
+                if frame.get("dropped"):
+                    yield {"type": "resync", "dropped": frame["dropped"]}
         finally:
-            self._close_socket()
+            # Closing the connection ends the subscription; it is never handed back to the pool
+            self._discard(connection)
 
     def send_command(self, command_type: str, params: Dict[str, Any]) -> Optional[Dict[str, Any]]:
-        """Send command with retry logic for transient connection errors."""
+        """Send command with retry logic for transient connection errors.
+
+        Every attempt carries the same idempotency key, so a command the editor already ran
+        before the connection dropped is answered from its stored response, not run twice.
+        """
         last_error = None
+        idempotency_key = uuid.uuid4().hex
 
         for attempt in range(MAX_RETRIES):
             try:
-                return self._send_command_once(command_type, params)
+                return self._send_command_once(command_type, params, idempotency_key)
 
-            except json.JSONDecodeError as e:
+            except DECODE_ERRORS as e:
                 log_error(f"'{command_type}' response decode failed", error=e)
                 return {"status": "error", "error": "Invalid response format from Unreal Engine"}
 
@@ -157,11 +669,49 @@ class UnrealSocketClient:
         response = self.send_command("ping", {})
         return response.get("status") == "success" if response else False
 
+    def run_job(
+        self,
+        command_type: str,
+        params: Dict[str, Any],
+        timeout: float,
+        poll_interval: float = JOB_POLL_INTERVAL
+    ) -> Dict[str, Any]:
+        """Run a long command as a server-side job and wait for it to finish.
+
+        Returns the command's own {"status", "result"/"error"} envelope. No request stays
+        open longer than one poll, so the command may outlast the socket timeout. On timeout
+        the job is cancelled; a slice that is already running still completes.
+        """
+        submitted = self.send_command(command_type, {**params, "async": True})
+        if not submitted or submitted.get("status") != "success":
+            return submitted or create_error_response("No response from Unreal Engine")
+
+        job_id = submitted["result"]["job_id"]
+        deadline = time.monotonic() + timeout
+        while True:
+            status = self.send_command("job_status", {"job_id": job_id})
+            if not status or status.get("status") != "success":
+                return status or create_error_response("No response from Unreal Engine")
+
+            job = status["result"]
+            if job.get("state") == "succeeded":
+                return {"status": "success", "result": job.get("result", {})}
+            if job.get("state") in JOB_FINAL_STATES:
+                return {"status": "error", "error": job.get("error") or f"Job {job.get('state')}"}
+
+            if time.monotonic() >= deadline:
+                self.send_command("cancel_job", {"job_id": job_id})
+                return {"status": "error", "error": f"Job {job_id} timed out after {timeout}s"}
+            time.sleep(poll_interval)
+
     def get_connection_status(self) -> Dict[str, Any]:
         return {
             "connected": self.ping(),
             "host": self.host,
-            "port": self.port
+            "port": self.port,
+            "transport": self.transport,
+            "socket_path": self.socket_path,
+            "pool": self.get_pool_stats()
         }
 
     def execute_command(
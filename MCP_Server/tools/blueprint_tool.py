@@ -267,14 +267,19 @@ def register_blueprint_tools(mcp: FastMCP):
     def compile_blueprint(
         blueprint_name: str,
         blueprint_path: str,
-        validate_only: bool = False
+        validate_only: bool = False,
+        run_as_job: bool = False
     ) -> Dict[str, Any]:
-        """Compile a Blueprint. Validates graph first, returns validation_issues on failure."""
-        return get_unreal_client().execute_command("compile_blueprint", {
+        """Compile a Blueprint. Validates graph first, returns validation_issues on failure.
+        With run_as_job, returns a job_id at once for large Blueprints; poll get_job_status."""
+        params = {
             "blueprint_name": blueprint_name,
             "blueprint_path": blueprint_path,
             "validate_only": validate_only
-        })
+        }
+        if run_as_job:
+            params["async"] = True
+        return get_unreal_client().execute_command("compile_blueprint", params)
 
     # =========================================================================
     # Component Tools
@@ -340,16 +340,25 @@ def register_editor_tools(mcp: FastMCP):
         x: float,
         y: float,
         z: float,
-        radius: float
+        radius: float,
+        run_as_job: bool = False
     ) -> Dict[str, Any]:
-        """Set load state of actors in a World Partition region."""
-        return get_unreal_client().execute_command("set_region_loaded", {
+        """Set load state of actors in a World Partition region.
+
+        Large regions can take longer than one request allows: with run_as_job the
+        call returns a job_id at once and actors load over several editor frames.
+        Follow up with get_job_status.
+        """
+        params = {
             "loaded": loaded,
             "x": float(x),
             "y": float(y),
             "z": float(z),
             "radius": float(radius)
-        })
+        }
+        if run_as_job:
+            params["async"] = True
+        return get_unreal_client().execute_command("set_region_loaded", params)
 
     # =========================================================================
     # Level Instance Tools
@@ -398,4 +407,63 @@ def register_editor_tools(mcp: FastMCP):
             return {"connected": False, "message": "Failed to ping Unreal Engine"}
         return client.get_connection_status()
 
+    @mcp.tool()
+    def execute_batch(
+        commands: List[Dict[str, Any]],
+        stop_on_error: bool = False,
+        transaction: bool = False
+    ) -> Dict[str, Any]:
+        """Run several plugin commands in one round trip and one editor tick.
+
+        Each entry is {"type": <command name>, "params": {...}}, e.g. a series of
+        add_blueprint_*_node and connect_blueprint_nodes calls. Returns one result
+        per entry, in order, with per-command timing. With stop_on_error the
+        remaining commands are skipped after the first failure.
+
+        Params can use results of earlier entries (0-based): a value of
+        "$step0.node_id" or "$step1.pins[0].name" is replaced by that field of
+        the entry's result, and "${step0.name}" is substituted inside longer
+        strings. An entry whose reference cannot be resolved fails without running.
+
+        transaction=True makes the batch all-or-nothing: the first failure undoes
+        every edit made by earlier entries (one editor undo step), and blueprints
+        are compiled once at the end instead of after each edit.
+        """
+        if not commands:
+            return create_error_response("No commands given")
+
+        pairs = []
+        for index, command in enumerate(commands):
+            command_type = command.get("type") if isinstance(command, dict) else None
+            if not command_type:
+                return create_error_response(f"Command {index} has no 'type'")
+            pairs.append((command_type, command.get("params") or {}))
+
+        return get_unreal_client().send_batch(pairs, stop_on_error, transaction)
+
+    @mcp.tool()
+    def get_job_status(job_id: str = "") -> Dict[str, Any]:
+        """Get state, progress and (once finished) result of a job started with
+        run_as_job. Without job_id, lists recent jobs."""
+        if not job_id:
+            return get_unreal_client().execute_command("list_jobs", {})
+        return get_unreal_client().execute_command("job_status", {"job_id": job_id})
+
+    @mcp.tool()
+    def cancel_job(job_id: str) -> Dict[str, Any]:
+        """Cancel a queued or running job. A running job stops before its next slice."""
+        return get_unreal_client().execute_command("cancel_job", {"job_id": job_id})
+
+    @mcp.tool()
+    def get_server_stats(command: str = "", reset: bool = False) -> Dict[str, Any]:
+        """Get per-command latency percentiles (p50/p90/p99, in ms) for each phase
+        of a request: queue wait, execution, serialization, socket send and total.
+        Also returns queue depth, requests rejected because the queue was full,
+        and bytes in/out. Pass command to see one command only; reset=True
+        starts a new measurement window after returning the current one."""
+        params: Dict[str, Any] = {"reset": bool(reset)}
+        if command:
+            params["command"] = command
+        return get_unreal_client().execute_command("get_server_stats", params)
+
     log_info("Editor tools registered successfully")
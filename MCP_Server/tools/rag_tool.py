@@ -223,19 +223,13 @@ def register_rag_tool(mcp: FastMCP):
 
             client = get_unreal_client()
 
-            try:
-                response = await asyncio.wait_for(
-                    asyncio.to_thread(
-                        client.execute_command,
-                        "execute_python",
-                        {"script": code}
-                    ),
-                    timeout=float(PYTHON_EXEC_TIMEOUT)
-                )
-            except asyncio.TimeoutError:
-                error_msg = f"Execution timed out ({PYTHON_EXEC_TIMEOUT}s)"
-                log_error(f"execute_unreal_python: {error_msg}")
-                return _create_execution_error_response(error_msg)
+            # Runs as a server-side job, so a script may take longer than one request timeout
+            response = await asyncio.to_thread(
+                client.run_job,
+                "execute_python",
+                {"script": code},
+                float(PYTHON_EXEC_TIMEOUT)
+            )
 
             if response.get("status") == "error":
                 return _create_execution_error_response(response.get("error", "Unknown error"))
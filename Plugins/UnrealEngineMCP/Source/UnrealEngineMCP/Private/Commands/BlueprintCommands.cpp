@@ -1,5 +1,7 @@
 #include "Commands/BlueprintCommands.h"
 #include "Commands/CommonUtils.h"
+#include "UnrealEngineMCPCommandRegistry.h"
+#include "UnrealEngineMCPResponseWriter.h"
 #include "Dom/JsonObject.h"
 #include "Kismet2/CompilerResultsLog.h"
 #include "Engine/Blueprint.h"
@@ -73,204 +75,375 @@ FBlueprintCommands::~FBlueprintCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FBlueprintCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FBlueprintCommands::RegisterCommands(FMcpCommandRegistry& Registry)
 {
-	if (CommandType == TEXT("create_blueprint"))
-	{
-		return HandleCreateBlueprint(Params);
-	}
-	else if (CommandType == TEXT("add_component_to_blueprint"))
-	{
-		return HandleAddComponentToBlueprint(Params);
-	}
-	else if (CommandType == TEXT("set_component_property"))
-	{
-		return HandleSetComponentProperty(Params);
-	}
-	else if (CommandType == TEXT("set_physics_properties"))
-	{
-		return HandleSetPhysicsProperties(Params);
-	}
-	else if (CommandType == TEXT("compile_blueprint"))
-	{
-		return HandleCompileBlueprint(Params);
-	}
-	else if (CommandType == TEXT("set_mesh_material_color"))
-	{
-		return HandleSetMeshMaterialColor(Params);
-	}
+	// Streaming handlers write the envelope themselves
+	Registry.Add(TEXT("analyze_blueprint"), FMcpStreamingCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAnalyzeBlueprint))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("include_all_graphs"), EMcpParamType::Boolean)
+		.Optional(TEXT("detailed_pins"), EMcpParamType::Boolean);
+
+	Registry.Add(TEXT("create_blueprint"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleCreateBlueprint))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Optional(TEXT("path"), EMcpParamType::String)
+		.Optional(TEXT("parent_class"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_component_to_blueprint"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddComponentToBlueprint))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_type"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("location"), EMcpParamType::Array)
+		.Optional(TEXT("rotation"), EMcpParamType::Array)
+		.Optional(TEXT("scale"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("set_component_property"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleSetComponentProperty))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Required(TEXT("property_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Required(TEXT("value"), EMcpParamType::Any)
+		.Optional(TEXT("property_value"), EMcpParamType::Any);
+
+	Registry.Add(TEXT("set_physics_properties"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleSetPhysicsProperties))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("simulate_physics"), EMcpParamType::Boolean)
+		.Optional(TEXT("mass"), EMcpParamType::Number)
+		.Optional(TEXT("enable_gravity"), EMcpParamType::Boolean);
+
+	Registry.Add(TEXT("compile_blueprint"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleCompileBlueprint))
+		.Cost(EMcpPriority::Bulk)
+		.Async()
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("validate_only"), EMcpParamType::Boolean);
+
+	Registry.Add(TEXT("set_mesh_material_color"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleSetMeshMaterialColor))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("color"), EMcpParamType::Array)
+		.Optional(TEXT("material_slot"), EMcpParamType::Number)
+		.Optional(TEXT("parameter_name"), EMcpParamType::String)
+		.Optional(TEXT("material_path"), EMcpParamType::String);
+
 	// Blueprint node graph commands (merged from BlueprintNodeCommands)
-	else if (CommandType == TEXT("connect_blueprint_nodes"))
-	{
-		return HandleConnectBlueprintNodes(Params);
-	}
-	else if (CommandType == TEXT("add_component_getter_node"))
-	{
-		return HandleAddComponentGetterNode(Params);
-	}
-	else if (CommandType == TEXT("add_blueprint_event_node"))
-	{
-		return HandleAddBlueprintEvent(Params);
-	}
-	else if (CommandType == TEXT("add_custom_event_node"))
-	{
-		return HandleAddCustomEventNode(Params);
-	}
-	else if (CommandType == TEXT("add_blueprint_function_node"))
-	{
-		return HandleAddBlueprintFunctionCall(Params);
-	}
-	else if (CommandType == TEXT("add_blueprint_variable"))
-	{
-		return HandleAddBlueprintVariable(Params);
-	}
-	else if (CommandType == TEXT("add_blueprint_input_action_node"))
-	{
-		return HandleAddBlueprintInputActionNode(Params);
-	}
-	else if (CommandType == TEXT("add_blueprint_self_reference"))
-	{
-		return HandleAddBlueprintSelfReference(Params);
-	}
-	else if (CommandType == TEXT("list_blueprint_nodes"))
-	{
-		return HandleListBlueprintNodes(Params);
-	}
+	Registry.Add(TEXT("connect_blueprint_nodes"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleConnectBlueprintNodes))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("source_pin"), EMcpParamType::String)
+		.Required(TEXT("target_pin"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("node_title"), EMcpParamType::String)
+		.Optional(TEXT("node_class"), EMcpParamType::String)
+		.Optional(TEXT("event_name"), EMcpParamType::String)
+		.Optional(TEXT("newest"), EMcpParamType::Boolean)
+		.Optional(TEXT("has_unconnected_exec_out"), EMcpParamType::Boolean)
+		.Optional(TEXT("source_node_id"), EMcpParamType::String)
+		.Optional(TEXT("source_search"), EMcpParamType::Object)
+		.Optional(TEXT("target_node_id"), EMcpParamType::String)
+		.Optional(TEXT("target_search"), EMcpParamType::Object);
+
+	Registry.Add(TEXT("add_component_getter_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddComponentGetterNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_blueprint_event_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddBlueprintEvent))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("event_name"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_custom_event_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddCustomEventNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("event_name"), EMcpParamType::String)
+		.Required(TEXT("action"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_blueprint_function_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddBlueprintFunctionCall))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("function_name"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("target_class"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("auto_connect_self"), EMcpParamType::Boolean)
+		.Optional(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("params"), EMcpParamType::Object);
+
+	Registry.Add(TEXT("add_blueprint_variable"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddBlueprintVariable))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("variable_name"), EMcpParamType::String)
+		.Required(TEXT("variable_type"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("sub_type"), EMcpParamType::String)
+		.Optional(TEXT("metadata"), EMcpParamType::Object);
+
+	Registry.Add(TEXT("add_blueprint_input_action_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddBlueprintInputActionNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("action_name"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_blueprint_self_reference"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddBlueprintSelfReference))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String);
+
+	Registry.Add(TEXT("list_blueprint_nodes"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleListBlueprintNodes))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("node_type"), EMcpParamType::String)
+		.Optional(TEXT("event_name"), EMcpParamType::String)
+		.Optional(TEXT("node_title"), EMcpParamType::String)
+		.Optional(TEXT("node_class"), EMcpParamType::String)
+		.Optional(TEXT("has_unconnected_pins"), EMcpParamType::Boolean)
+		.Optional(TEXT("has_unconnected_exec_pins"), EMcpParamType::Boolean)
+		.Optional(TEXT("has_unconnected_data_pins"), EMcpParamType::Boolean)
+		.Optional(TEXT("limit"), EMcpParamType::Number)
+		.Optional(TEXT("sort_by"), EMcpParamType::String);
+
 	// Material commands
-	else if (CommandType == TEXT("apply_material_to_blueprint"))
-	{
-		return HandleApplyMaterialToBlueprint(Params);
-	}
-	else if (CommandType == TEXT("get_blueprint_material_info"))
-	{
-		return HandleGetBlueprintMaterialInfo(Params);
-	}
+	Registry.Add(TEXT("apply_material_to_blueprint"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleApplyMaterialToBlueprint))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Required(TEXT("material_path"), EMcpParamType::String)
+		.Optional(TEXT("material_slot"), EMcpParamType::Number)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("get_blueprint_material_info"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleGetBlueprintMaterialInfo))
+		.ReadOnly()
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
 	// Organization commands
-	else if (CommandType == TEXT("add_comment_box"))
-	{
-		return HandleAddCommentBox(Params);
-	}
-	else if (CommandType == TEXT("analyze_blueprint"))
-	{
-		return HandleAnalyzeBlueprint(Params);
-	}
+	Registry.Add(TEXT("add_comment_box"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddCommentBox))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("comment_text"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("position"), EMcpParamType::Array)
+		.Optional(TEXT("size"), EMcpParamType::Array);
+
 	// GAS (Gameplay Ability System) commands
-	else if (CommandType == TEXT("create_gameplay_effect"))
-	{
-		return HandleCreateGameplayEffect(Params);
-	}
-	else if (CommandType == TEXT("create_gameplay_ability"))
-	{
-		return HandleCreateGameplayAbility(Params);
-	}
+	Registry.Add(TEXT("create_gameplay_effect"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleCreateGameplayEffect))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Optional(TEXT("asset_path"), EMcpParamType::String)
+		.Optional(TEXT("parent_class"), EMcpParamType::String)
+		.Optional(TEXT("duration_policy"), EMcpParamType::String)
+		.Optional(TEXT("duration"), EMcpParamType::Number)
+		.Optional(TEXT("period"), EMcpParamType::Number)
+		.Optional(TEXT("modifiers"), EMcpParamType::Array)
+		.Optional(TEXT("granted_tags"), EMcpParamType::Array)
+		.Optional(TEXT("application_required_tags"), EMcpParamType::Array)
+		.Optional(TEXT("application_blocked_tags"), EMcpParamType::Array)
+		.Optional(TEXT("executions"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("create_gameplay_ability"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleCreateGameplayAbility))
+		.Cost(EMcpPriority::Bulk)
+		.Async()
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Optional(TEXT("asset_path"), EMcpParamType::String)
+		.Optional(TEXT("parent_class"), EMcpParamType::String)
+		.Optional(TEXT("auto_setup_lifecycle"), EMcpParamType::Boolean)
+		.Optional(TEXT("ability_tags"), EMcpParamType::Array)
+		.Optional(TEXT("cancel_abilities_with_tags"), EMcpParamType::Array)
+		.Optional(TEXT("block_abilities_with_tags"), EMcpParamType::Array)
+		.Optional(TEXT("cost_gameplay_effect"), EMcpParamType::String)
+		.Optional(TEXT("cooldown_gameplay_effect"), EMcpParamType::String)
+		.Optional(TEXT("instancing_policy"), EMcpParamType::String)
+		.Optional(TEXT("net_execution_policy"), EMcpParamType::String)
+		.Optional(TEXT("activation_required_tags"), EMcpParamType::Array)
+		.Optional(TEXT("activation_blocked_tags"), EMcpParamType::Array);
+
 	// GAS AttributeSet commands
-	else if (CommandType == TEXT("list_attribute_sets"))
-	{
-		return HandleListAttributeSets(Params);
-	}
-	else if (CommandType == TEXT("get_attribute_set_info"))
-	{
-		return HandleGetAttributeSetInfo(Params);
-	}
+	Registry.Add(TEXT("list_attribute_sets"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleListAttributeSets))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Optional(TEXT("include_engine"), EMcpParamType::Boolean)
+		.Optional(TEXT("limit"), EMcpParamType::Number);
+
+	Registry.Add(TEXT("get_attribute_set_info"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleGetAttributeSetInfo))
+		.ReadOnly()
+		.Required(TEXT("attribute_set_name"), EMcpParamType::String);
+
 	// Tier 1: Core Blueprint node tools
-	else if (CommandType == TEXT("add_blueprint_flow_control_node"))
-	{
-		return HandleAddBlueprintFlowControlNode(Params);
-	}
-	else if (CommandType == TEXT("set_pin_default_value"))
-	{
-		return HandleSetPinDefaultValue(Params);
-	}
-	else if (CommandType == TEXT("get_pin_value"))
-	{
-		return HandleGetPinValue(Params);
-	}
-	else if (CommandType == TEXT("add_blueprint_variable_node"))
-	{
-		return HandleAddBlueprintVariableNode(Params);
-	}
-	else if (CommandType == TEXT("search_functions"))
-	{
-		return HandleSearchFunctions(Params);
-	}
-	else if (CommandType == TEXT("get_class_functions"))
-	{
-		return HandleGetClassFunctions(Params);
-	}
-	else if (CommandType == TEXT("get_class_properties"))
-	{
-		return HandleGetClassProperties(Params);
-	}
-	else if (CommandType == TEXT("get_blueprint_variables"))
-	{
-		return HandleGetBlueprintVariables(Params);
-	}
-	else if (CommandType == TEXT("add_property_get_set_node"))
-	{
-		return HandleAddPropertyGetSetNode(Params);
-	}
-	else if (CommandType == TEXT("add_function_override"))
-	{
-		return HandleAddFunctionOverride(Params);
-	}
-	else if (CommandType == TEXT("add_ability_task_node"))
-	{
-		return HandleAddAbilityTaskNode(Params);
-	}
+	Registry.Add(TEXT("add_blueprint_flow_control_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddBlueprintFlowControlNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("control_type"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String);
+
+	Registry.Add(TEXT("set_pin_default_value"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleSetPinDefaultValue))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Required(TEXT("pin_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Required(TEXT("value"), EMcpParamType::Any);
+
+	Registry.Add(TEXT("get_pin_value"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleGetPinValue))
+		.ReadOnly()
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Required(TEXT("pin_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_blueprint_variable_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddBlueprintVariableNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("variable_name"), EMcpParamType::String)
+		.Required(TEXT("node_type"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String);
+
+	Registry.Add(TEXT("search_functions"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleSearchFunctions))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Required(TEXT("keyword"), EMcpParamType::String)
+		.Optional(TEXT("class_filter"), EMcpParamType::String)
+		.Optional(TEXT("max_results"), EMcpParamType::Number);
+
+	Registry.Add(TEXT("get_class_functions"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleGetClassFunctions))
+		.ReadOnly()
+		.ThreadSafe()
+		.Required(TEXT("class_name"), EMcpParamType::String)
+		.Optional(TEXT("include_inherited"), EMcpParamType::Boolean)
+		.Optional(TEXT("callable_only"), EMcpParamType::Boolean);
+
+	Registry.Add(TEXT("get_class_properties"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleGetClassProperties))
+		.ReadOnly()
+		.ThreadSafe()
+		.Required(TEXT("class_name"), EMcpParamType::String)
+		.Optional(TEXT("include_inherited"), EMcpParamType::Boolean)
+		.Optional(TEXT("blueprint_visible_only"), EMcpParamType::Boolean);
+
+	Registry.Add(TEXT("get_blueprint_variables"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleGetBlueprintVariables))
+		.ReadOnly()
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_property_get_set_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddPropertyGetSetNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("owner_class"), EMcpParamType::String)
+		.Required(TEXT("property_name"), EMcpParamType::String)
+		.Required(TEXT("node_type"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("add_function_override"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddFunctionOverride))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("function_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("add_ability_task_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddAbilityTaskNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("task_class"), EMcpParamType::String)
+		.Required(TEXT("function_name"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String);
+
 	// Generic node tools
-	else if (CommandType == TEXT("add_blueprint_generic_node"))
-	{
-		return HandleAddGenericNode(Params);
-	}
-	else if (CommandType == TEXT("set_node_property"))
-	{
-		return HandleSetNodeProperty(Params);
-	}
-	else if (CommandType == TEXT("connect_nodes"))
-	{
-		return HandleConnectNodes(Params);
-	}
-	else if (CommandType == TEXT("list_graphs"))
-	{
-		return HandleListGraphs(Params);
-	}
-	else if (CommandType == TEXT("create_child_blueprint"))
-	{
-		return HandleCreateChildBlueprint(Params);
-	}
+	Registry.Add(TEXT("add_blueprint_generic_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddGenericNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_class"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("struct_type"), EMcpParamType::String)
+		.Optional(TEXT("enum"), EMcpParamType::String)
+		.Optional(TEXT("target_type"), EMcpParamType::String)
+		.Optional(TEXT("actor_class"), EMcpParamType::String)
+		.Optional(TEXT("object_class"), EMcpParamType::String);
+
+	Registry.Add(TEXT("set_node_property"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleSetNodeProperty))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Required(TEXT("property_path"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Required(TEXT("value"), EMcpParamType::Any);
+
+	Registry.Add(TEXT("connect_nodes"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleConnectNodes))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("source_node_id"), EMcpParamType::String)
+		.Required(TEXT("target_node_id"), EMcpParamType::String)
+		.Optional(TEXT("connect_exec"), EMcpParamType::Boolean)
+		.Optional(TEXT("connect_data"), EMcpParamType::Boolean)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("list_graphs"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleListGraphs))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("create_child_blueprint"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleCreateChildBlueprint))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Required(TEXT("parent_blueprint"), EMcpParamType::String)
+		.Optional(TEXT("asset_path"), EMcpParamType::String);
+
 	// Declarative graph builder
-	else if (CommandType == TEXT("build_ability_graph"))
-	{
-		return HandleBuildAbilityGraph(Params);
-	}
+	Registry.Add(TEXT("build_ability_graph"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleBuildAbilityGraph))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("nodes"), EMcpParamType::Array)
+		.Required(TEXT("connections"), EMcpParamType::Array)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("auto_layout"), EMcpParamType::Boolean)
+		.Optional(TEXT("pin_defaults"), EMcpParamType::Array);
+
 	// Deletion commands
-	else if (CommandType == TEXT("delete_blueprint_node"))
-	{
-		return HandleDeleteBlueprintNode(Params);
-	}
-	else if (CommandType == TEXT("delete_blueprint_variable"))
-	{
-		return HandleDeleteBlueprintVariable(Params);
-	}
-	else if (CommandType == TEXT("delete_component_from_blueprint"))
-	{
-		return HandleDeleteComponentFromBlueprint(Params);
-	}
-	else if (CommandType == TEXT("disconnect_blueprint_nodes"))
-	{
-		return HandleDisconnectBlueprintNodes(Params);
-	}
-	// Dynamic pin management
-	else if (CommandType == TEXT("add_pin"))
-	{
-		return HandleAddPin(Params);
-	}
-	else if (CommandType == TEXT("delete_pin"))
-	{
-		return HandleDeletePin(Params);
-	}
+	Registry.Add(TEXT("delete_blueprint_node"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleDeleteBlueprintNode))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("delete_blueprint_variable"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleDeleteBlueprintVariable))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("variable_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("delete_component_from_blueprint"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleDeleteComponentFromBlueprint))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("disconnect_blueprint_nodes"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleDisconnectBlueprintNodes))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Required(TEXT("pin_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
 
-	return FCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint command: %s"), *CommandType));
+	// Dynamic pin management
+	Registry.Add(TEXT("add_pin"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleAddPin))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("pin_name"), EMcpParamType::String);
+
+	Registry.Add(TEXT("delete_pin"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleDeletePin))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Required(TEXT("pin_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String);
 }
 
 TSharedPtr<FJsonObject> FBlueprintCommands::HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -430,7 +603,7 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleAddComponentToBlueprint(const
 		Blueprint->SimpleConstructionScript->AddNode(NewNode);
 
 		// Compile the blueprint
-		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+		FCommonUtils::CompileBlueprint(Blueprint);
 
 		TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 		ResultObj->SetStringField(TEXT("component_name"), ComponentName);
@@ -616,7 +789,7 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleSetPhysicsProperties(const TSh
 	}
 
 	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FCommonUtils::CompileBlueprint(Blueprint);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetStringField(TEXT("component"), ComponentName);
@@ -2813,12 +2986,13 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleAddCommentBox(const TSharedPtr
 	return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FBlueprintCommands::HandleAnalyzeBlueprint(const TSharedPtr<FJsonObject>& Params)
+void FBlueprintCommands::HandleAnalyzeBlueprint(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& Writer)
 {
 	FString BlueprintName;
 	if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
 	{
-		return FCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+		Writer.WriteError(TEXT("Missing 'blueprint_name' parameter"));
+		return;
 	}
 
 	FString BlueprintPath = TEXT("/Game/Blueprints/");
@@ -2833,7 +3007,8 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleAnalyzeBlueprint(const TShared
 	UBlueprint* Blueprint = FCommonUtils::FindBlueprint(BlueprintName, BlueprintPath);
 	if (!Blueprint)
 	{
-		return FCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+		Writer.WriteError(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+		return;
 	}
 
 	// Get graphs to analyze
@@ -2848,13 +3023,18 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleAnalyzeBlueprint(const TShared
 		if (EventGraph) GraphsToAnalyze.Add(EventGraph);
 	}
 
-	// Collect graph information
-	TArray<TSharedPtr<FJsonValue>> GraphsArray;
+	Writer.BeginSuccess();
+	Writer.Values().WriteValue(TEXT("blueprint"), BlueprintName);
+	Writer.Values().WriteValue(TEXT("parent_class"), Blueprint->ParentClass ? Blueprint->ParentClass->GetName() : TEXT("None"));
+
+	// Collect graph information - each graph is written (or streamed) as soon as it is built
+	FMcpItemWriter Graphs(Writer, TEXT("graphs"));
 	TMap<FString, int32> NodeTypeCounts;
 	int32 TotalNodeCount = 0;
 
 	for (UEdGraph* Graph : GraphsToAnalyze)
 	{
+		if (Graphs.IsCancelled()) break;
 		if (!Graph) continue;
 
 		TSharedPtr<FJsonObject> GraphInfo = FCommonUtils::GraphToJson(Graph);
@@ -2885,8 +3065,9 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleAnalyzeBlueprint(const TShared
 		}
 
 		GraphInfo->SetArrayField(TEXT("nodes"), NodesArray);
-		GraphsArray.Add(MakeShared<FJsonValueObject>(GraphInfo));
+		Graphs.AddItem(GraphInfo);
 	}
+	Graphs.Finish();
 
 	// Build type summary
 	TArray<TSharedPtr<FJsonValue>> TypeSummaryArray;
@@ -2941,18 +3122,14 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleAnalyzeBlueprint(const TShared
 		}
 	}
 
-	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-	ResultObj->SetStringField(TEXT("blueprint"), BlueprintName);
-	ResultObj->SetStringField(TEXT("parent_class"), Blueprint->ParentClass ? Blueprint->ParentClass->GetName() : TEXT("None"));
-	ResultObj->SetNumberField(TEXT("total_node_count"), TotalNodeCount);
-	ResultObj->SetNumberField(TEXT("graph_count"), GraphsArray.Num());
-	ResultObj->SetArrayField(TEXT("graphs"), GraphsArray);
-	ResultObj->SetArrayField(TEXT("node_type_summary"), TypeSummaryArray);
-	ResultObj->SetArrayField(TEXT("components"), ComponentsArray);
-	ResultObj->SetArrayField(TEXT("variables"), VariablesArray);
-	ResultObj->SetArrayField(TEXT("overridable_functions"), OverridablesArray);
-	ResultObj->SetBoolField(TEXT("success"), true);
-	return ResultObj;
+	Writer.Values().WriteValue(TEXT("total_node_count"), TotalNodeCount);
+	Writer.Values().WriteValue(TEXT("graph_count"), Graphs.Num());
+	Writer.WriteField(TEXT("node_type_summary"), MakeShared<FJsonValueArray>(TypeSummaryArray));
+	Writer.WriteField(TEXT("components"), MakeShared<FJsonValueArray>(ComponentsArray));
+	Writer.WriteField(TEXT("variables"), MakeShared<FJsonValueArray>(VariablesArray));
+	Writer.WriteField(TEXT("overridable_functions"), MakeShared<FJsonValueArray>(OverridablesArray));
+	Writer.Values().WriteValue(TEXT("success"), true);
+	Writer.EndSuccess();
 }
 
 // ============================================================================
@@ -5553,7 +5730,7 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleDeleteBlueprintNode(const TSha
 	UEdGraph* OwningGraph = TargetNode->GetGraph();
 	FString NodeTitle = TargetNode->GetNodeTitle(ENodeTitleType::ListView).ToString();
 	OwningGraph->RemoveNode(TargetNode);
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FCommonUtils::CompileBlueprint(Blueprint);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
@@ -5593,7 +5770,7 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleDeleteBlueprintVariable(const
 	}
 
 	FBlueprintEditorUtils::RemoveMemberVariable(Blueprint, VarName);
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FCommonUtils::CompileBlueprint(Blueprint);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
@@ -5641,7 +5818,7 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleDeleteComponentFromBlueprint(c
 	}
 
 	Blueprint->SimpleConstructionScript->RemoveNode(CompResult.SCSNode);
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FCommonUtils::CompileBlueprint(Blueprint);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
@@ -5701,7 +5878,7 @@ TSharedPtr<FJsonObject> FBlueprintCommands::HandleDisconnectBlueprintNodes(const
 
 	int32 DisconnectedCount = TargetPin->LinkedTo.Num();
 	TargetPin->BreakAllPinLinks();
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FCommonUtils::CompileBlueprint(Blueprint);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
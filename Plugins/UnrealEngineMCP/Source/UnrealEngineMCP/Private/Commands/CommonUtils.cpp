@@ -34,6 +34,10 @@
 // Static storage for World Partition actor references (to keep actors loaded)
 static TArray<FWorldPartitionReference> GAutoLoadedActorRefs;
 
+// Blueprints edited while compilation is deferred (game thread only)
+static bool GDeferBlueprintCompilation = false;
+static TArray<TWeakObjectPtr<UBlueprint>> GDeferredBlueprints;
+
 // JSON Utilities
 TSharedPtr<FJsonObject> FCommonUtils::CreateErrorResponse(const FString& Message)
 {
@@ -172,6 +176,44 @@ UBlueprint* FCommonUtils::FindBlueprintByName(const FString& BlueprintName, cons
 	return LoadObject<UBlueprint>(nullptr, *AssetPath);
 }
 
+void FCommonUtils::CompileBlueprint(UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	if (GDeferBlueprintCompilation)
+	{
+		GDeferredBlueprints.AddUnique(Blueprint);
+		return;
+	}
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+}
+
+void FCommonUtils::BeginDeferredCompilation()
+{
+	GDeferBlueprintCompilation = true;
+	GDeferredBlueprints.Reset();
+}
+
+TArray<UBlueprint*> FCommonUtils::EndDeferredCompilation()
+{
+	GDeferBlueprintCompilation = false;
+
+	TArray<UBlueprint*> Blueprints;
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : GDeferredBlueprints)
+	{
+		if (Blueprint.IsValid())
+		{
+			Blueprints.Add(Blueprint.Get());
+		}
+	}
+	GDeferredBlueprints.Reset();
+	return Blueprints;
+}
+
 FBlueprintComponentResult FCommonUtils::FindBlueprintComponent(
 	UBlueprint* Blueprint,
 	const FString& ComponentName,
@@ -1069,7 +1111,10 @@ UClass* FCommonUtils::FindClassByName(const FString& ClassName)
 		for (const FString& TestName : ClassNameVariants)
 		{
 			FString FullPath = Module + TEXT(".") + TestName;
-			FoundClass = LoadClass<UObject>(nullptr, *FullPath);
+			// Script packages are always in memory, so worker threads can find without loading
+			FoundClass = IsInGameThread()
+				? LoadClass<UObject>(nullptr, *FullPath)
+				: FindObject<UClass>(nullptr, *FullPath);
 			if (FoundClass)
 			{
 				return FoundClass;
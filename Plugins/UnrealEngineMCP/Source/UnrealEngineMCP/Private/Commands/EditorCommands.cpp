@@ -1,5 +1,7 @@
 #include "Commands/EditorCommands.h"
 #include "Commands/CommonUtils.h"
+#include "UnrealEngineMCPCommandRegistry.h"
+#include "UnrealEngineMCPResponseWriter.h"
 #include "Dom/JsonObject.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/World.h"
@@ -37,6 +39,9 @@
 #include "LevelInstance/LevelInstanceEditorInstanceActor.h"
 #include "Interfaces/IPluginManager.h"
 
+// Actors a set_region_loaded job loads per editor tick
+#define MCP_REGION_LOAD_ACTORS_PER_SLICE 32
+
 FEditorCommands::FEditorCommands()
 {
 }
@@ -45,94 +50,141 @@ FEditorCommands::~FEditorCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FEditorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FEditorCommands::RegisterCommands(FMcpCommandRegistry& Registry)
 {
-	if (CommandType == TEXT("spawn_actor"))
-	{
-		return HandleSpawnActor(Params);
-	}
-	else if (CommandType == TEXT("list_level_actors"))
-	{
-		return HandleListLevelActors(Params);
-	}
-	else if (CommandType == TEXT("delete_actor"))
-	{
-		return HandleDeleteActor(Params);
-	}
-	else if (CommandType == TEXT("set_actor_transform"))
-	{
-		return HandleSetActorTransform(Params);
-	}
-	else if (CommandType == TEXT("get_actor_properties"))
-	{
-		return HandleGetActorProperties(Params);
-	}
-	else if (CommandType == TEXT("set_actor_property"))
-	{
-		return HandleSetActorProperty(Params);
-	}
-	else if (CommandType == TEXT("spawn_blueprint_actor"))
-	{
-		return HandleSpawnBlueprintActor(Params);
-	}
-	else if (CommandType == TEXT("create_material"))
-	{
-		return HandleCreateMaterial(Params);
-	}
-	else if (CommandType == TEXT("search_actors"))
-	{
-		return HandleSearchActors(Params);
-	}
+	// Streaming handlers write the envelope themselves
+	Registry.Add(TEXT("list_level_actors"), FMcpStreamingCommandDelegate::CreateRaw(this, &FEditorCommands::HandleListLevelActors))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Optional(TEXT("include_level_instances"), EMcpParamType::Boolean);
+
+	Registry.Add(TEXT("search_actors"), FMcpStreamingCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSearchActors))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Optional(TEXT("pattern"), EMcpParamType::String)
+		.Optional(TEXT("class_filter"), EMcpParamType::String)
+		.Optional(TEXT("limit"), EMcpParamType::Number)
+		.Optional(TEXT("include_level_instances"), EMcpParamType::Boolean)
+		.Optional(TEXT("level_instance_filter"), EMcpParamType::String);
+
+	Registry.Add(TEXT("spawn_actor"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSpawnActor))
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Required(TEXT("type"), EMcpParamType::String)
+		.Optional(TEXT("location"), EMcpParamType::Array)
+		.Optional(TEXT("rotation"), EMcpParamType::Array)
+		.Optional(TEXT("scale"), EMcpParamType::Array)
+		.Optional(TEXT("static_mesh"), EMcpParamType::String);
+
+	Registry.Add(TEXT("delete_actor"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleDeleteActor))
+		.Required(TEXT("name"), EMcpParamType::String);
+
+	Registry.Add(TEXT("set_actor_transform"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSetActorTransform))
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Optional(TEXT("location"), EMcpParamType::Array)
+		.Optional(TEXT("rotation"), EMcpParamType::Array)
+		.Optional(TEXT("scale"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("get_actor_properties"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleGetActorProperties))
+		.ReadOnly()
+		.Required(TEXT("name"), EMcpParamType::String);
+
+	Registry.Add(TEXT("set_actor_property"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSetActorProperty))
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Required(TEXT("property_name"), EMcpParamType::String)
+		.Required(TEXT("property_value"), EMcpParamType::Any);
+
+	Registry.Add(TEXT("spawn_blueprint_actor"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSpawnBlueprintActor))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("actor_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("location"), EMcpParamType::Array)
+		.Optional(TEXT("rotation"), EMcpParamType::Array)
+		.Optional(TEXT("scale"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("create_material"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleCreateMaterial))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("material_name"), EMcpParamType::String)
+		.Optional(TEXT("color"), EMcpParamType::Array)
+		.Optional(TEXT("material_path"), EMcpParamType::String);
+
 	// Material commands
-	else if (CommandType == TEXT("apply_material_to_actor"))
-	{
-		return HandleApplyMaterialToActor(Params);
-	}
-	else if (CommandType == TEXT("get_actor_material_info"))
-	{
-		return HandleGetActorMaterialInfo(Params);
-	}
-	else if (CommandType == TEXT("search_assets"))
-	{
-		return HandleSearchAssets(Params);
-	}
-	else if (CommandType == TEXT("list_folder_assets"))
-	{
-		return HandleListFolderAssets(Params);
-	}
+	Registry.Add(TEXT("apply_material_to_actor"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleApplyMaterialToActor))
+		.Required(TEXT("actor_name"), EMcpParamType::String)
+		.Required(TEXT("material_path"), EMcpParamType::String)
+		.Optional(TEXT("material_slot"), EMcpParamType::Number);
+
+	Registry.Add(TEXT("get_actor_material_info"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleGetActorMaterialInfo))
+		.ReadOnly()
+		.Required(TEXT("actor_name"), EMcpParamType::String);
+
+	// Only asset-scope searches without base_class leave the game thread, see the bridge
+	Registry.Add(TEXT("search_assets"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSearchAssets))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.ThreadSafe()
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Required(TEXT("search_scope"), EMcpParamType::String)
+		.Optional(TEXT("object_type"), EMcpParamType::String)
+		.Optional(TEXT("search_path"), EMcpParamType::String)
+		.Optional(TEXT("base_class"), EMcpParamType::String)
+		.Optional(TEXT("limit"), EMcpParamType::Number);
+
+	Registry.Add(TEXT("list_folder_assets"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleListFolderAssets))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.ThreadSafe()
+		.Required(TEXT("folder_path"), EMcpParamType::String)
+		.Optional(TEXT("asset_type"), EMcpParamType::String)
+		.Optional(TEXT("recursive"), EMcpParamType::Boolean)
+		.Optional(TEXT("limit"), EMcpParamType::Number);
+
 	// World Partition commands
-	else if (CommandType == TEXT("search_actors_in_region"))
-	{
-		return HandleSearchActorsInRegion(Params);
-	}
-	else if (CommandType == TEXT("load_actor_by_guid"))
-	{
-		return HandleLoadActorByGuid(Params);
-	}
-	else if (CommandType == TEXT("set_region_loaded"))
-	{
-		return HandleSetRegionLoaded(Params);
-	}
-	else if (CommandType == TEXT("get_world_partition_info"))
-	{
-		return HandleGetWorldPartitionInfo(Params);
-	}
+	Registry.Add(TEXT("search_actors_in_region"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSearchActorsInRegion))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Optional(TEXT("center"), EMcpParamType::Array)
+		.Optional(TEXT("x"), EMcpParamType::Number)
+		.Optional(TEXT("y"), EMcpParamType::Number)
+		.Optional(TEXT("z"), EMcpParamType::Number)
+		.Optional(TEXT("radius"), EMcpParamType::Number)
+		.Optional(TEXT("extent"), EMcpParamType::Array)
+		.Optional(TEXT("class_filter"), EMcpParamType::String)
+		.Optional(TEXT("limit"), EMcpParamType::Number);
+
+	Registry.Add(TEXT("load_actor_by_guid"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleLoadActorByGuid))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("guid"), EMcpParamType::String);
+
+	Registry.Add(TEXT("set_region_loaded"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleSetRegionLoaded))
+		.Cost(EMcpPriority::Bulk)
+		.Async()
+		.Required(TEXT("loaded"), EMcpParamType::Boolean)
+		.Optional(TEXT("center"), EMcpParamType::Array)
+		.Optional(TEXT("x"), EMcpParamType::Number)
+		.Optional(TEXT("y"), EMcpParamType::Number)
+		.Optional(TEXT("z"), EMcpParamType::Number)
+		.Required(TEXT("radius"), EMcpParamType::Number);
+
+	Registry.Add(TEXT("get_world_partition_info"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleGetWorldPartitionInfo))
+		.ReadOnly();
+
 	// GAS Tag commands
-	else if (CommandType == TEXT("list_gameplay_tags"))
-	{
-		return HandleListGameplayTags(Params);
-	}
+	Registry.Add(TEXT("list_gameplay_tags"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleListGameplayTags))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.ThreadSafe()
+		.Optional(TEXT("prefix"), EMcpParamType::String)
+		.Optional(TEXT("max_depth"), EMcpParamType::Number)
+		.Optional(TEXT("limit"), EMcpParamType::Number);
+
 	// Level Instance commands
-	else if (CommandType == TEXT("list_level_instances"))
-	{
-		return HandleListLevelInstances(Params);
-	}
-	else if (CommandType == TEXT("get_level_instance_actors"))
-	{
-		return HandleGetLevelInstanceActors(Params);
-	}
+	Registry.Add(TEXT("list_level_instances"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleListLevelInstances))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly);
 
-	return FCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
+	Registry.Add(TEXT("get_level_instance_actors"), FMcpCommandDelegate::CreateRaw(this, &FEditorCommands::HandleGetLevelInstanceActors))
+		.ReadOnly()
+		.Required(TEXT("level_instance_name"), EMcpParamType::String);
 }
 
 TSharedPtr<FJsonObject> FEditorCommands::HandleSpawnActor(const TSharedPtr<FJsonObject>& Params)
@@ -298,97 +350,104 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleSpawnActor(const TSharedPtr<FJson
 	return FCommonUtils::CreateErrorResponse(TEXT("Failed to spawn actor"));
 }
 
-TSharedPtr<FJsonObject> FEditorCommands::HandleListLevelActors(const TSharedPtr<FJsonObject>& Params)
+void FEditorCommands::HandleListLevelActors(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& Writer)
 {
 	UWorld* World = GEditor->GetEditorWorldContext().World();
 	if (!World)
 	{
-		return FCommonUtils::CreateErrorResponse(TEXT("No editor world available"));
+		Writer.WriteError(TEXT("No editor world available"));
+		return;
 	}
 
 	bool bIncludeLevelInstances = true;
 	Params->TryGetBoolField(TEXT("include_level_instances"), bIncludeLevelInstances);
 
-	TArray<TSharedPtr<FJsonValue>> ActorsArray;
-	TArray<TSharedPtr<FJsonValue>> LevelInstancesArray;
+	// Large levels produce huge listings - emit each actor directly instead of building a DOM
+	Writer.BeginSuccess();
+	Writer.Values().WriteValue(TEXT("success"), true);
 
+	FMcpItemWriter Actors(Writer, TEXT("actors"));
 	FCommonUtils::ForEachActorInWorld(World, [&](AActor* Actor, ALevelInstance* OwningLI) -> bool
 	{
+		if (Actors.IsCancelled())
+		{
+			return false;
+		}
+
 		if (!Actor || Actor->IsHidden())
 		{
 			return true;
 		}
 
-		TSharedPtr<FJsonObject> ActorInfo = MakeShared<FJsonObject>();
-		ActorInfo->SetStringField(TEXT("name"), Actor->GetName());
-		ActorInfo->SetStringField(TEXT("label"), Actor->GetActorLabel());
-		ActorInfo->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+		FMcpValueWriter& Values = Actors.BeginItem();
+		Values.WriteValue(TEXT("name"), Actor->GetName());
+		Values.WriteValue(TEXT("label"), Actor->GetActorLabel());
+		Values.WriteValue(TEXT("class"), Actor->GetClass()->GetName());
 
-		FVector Location = Actor->GetActorLocation();
-		TArray<TSharedPtr<FJsonValue>> LocationArray;
-		LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
-		LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
-		LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
-		ActorInfo->SetArrayField(TEXT("location"), LocationArray);
+		const FVector Location = Actor->GetActorLocation();
+		Values.WriteArrayStart(TEXT("location"));
+		Values.WriteValue(Location.X);
+		Values.WriteValue(Location.Y);
+		Values.WriteValue(Location.Z);
+		Values.WriteArrayEnd();
 
 		if (OwningLI)
 		{
-			ActorInfo->SetStringField(TEXT("level_instance"), OwningLI->GetName());
-			ActorInfo->SetStringField(TEXT("level_instance_label"), OwningLI->GetActorLabel());
+			Values.WriteValue(TEXT("level_instance"), OwningLI->GetName());
+			Values.WriteValue(TEXT("level_instance_label"), OwningLI->GetActorLabel());
 		}
 
-		ActorsArray.Add(MakeShared<FJsonValueObject>(ActorInfo));
+		Actors.EndItem();
 		return true;
 	}, bIncludeLevelInstances);
+	Actors.Finish();
 
 	// Collect Level Instance info
+	FMcpValueWriter& Values = Writer.Values();
 	TArray<ALevelInstance*> LevelInstances = FCommonUtils::GetAllLevelInstances(World);
+	Values.WriteArrayStart(TEXT("level_instances"));
 	for (ALevelInstance* LI : LevelInstances)
 	{
-		TSharedPtr<FJsonObject> LIInfo = MakeShared<FJsonObject>();
-		LIInfo->SetStringField(TEXT("name"), LI->GetName());
-		LIInfo->SetStringField(TEXT("label"), LI->GetActorLabel());
-		LIInfo->SetStringField(TEXT("class"), LI->GetClass()->GetName());
+		Values.WriteObjectStart();
+		Values.WriteValue(TEXT("name"), LI->GetName());
+		Values.WriteValue(TEXT("label"), LI->GetActorLabel());
+		Values.WriteValue(TEXT("class"), LI->GetClass()->GetName());
 
 		if (TSoftObjectPtr<UWorld> WorldAsset = LI->GetWorldAsset())
 		{
-			LIInfo->SetStringField(TEXT("world_asset"), WorldAsset.ToString());
+			Values.WriteValue(TEXT("world_asset"), WorldAsset.ToString());
 		}
 
-		FVector LILocation = LI->GetActorLocation();
-		TArray<TSharedPtr<FJsonValue>> LILocationArray;
-		LILocationArray.Add(MakeShared<FJsonValueNumber>(LILocation.X));
-		LILocationArray.Add(MakeShared<FJsonValueNumber>(LILocation.Y));
-		LILocationArray.Add(MakeShared<FJsonValueNumber>(LILocation.Z));
-		LIInfo->SetArrayField(TEXT("location"), LILocationArray);
+		const FVector LILocation = LI->GetActorLocation();
+		Values.WriteArrayStart(TEXT("location"));
+		Values.WriteValue(LILocation.X);
+		Values.WriteValue(LILocation.Y);
+		Values.WriteValue(LILocation.Z);
+		Values.WriteArrayEnd();
 
 		ULevel* LoadedLevel = FCommonUtils::GetLevelInstanceLoadedLevel(LI);
-		LIInfo->SetBoolField(TEXT("is_loaded"), LoadedLevel != nullptr);
+		Values.WriteValue(TEXT("is_loaded"), LoadedLevel != nullptr);
 
 		if (LoadedLevel)
 		{
-			int32 ActorCount = 0;
+			int32 LIActorCount = 0;
 			for (AActor* A : LoadedLevel->Actors)
 			{
 				if (A && !A->IsA<ALevelInstanceEditorInstanceActor>())
 				{
-					ActorCount++;
+					LIActorCount++;
 				}
 			}
-			LIInfo->SetNumberField(TEXT("actor_count"), ActorCount);
+			Values.WriteValue(TEXT("actor_count"), LIActorCount);
 		}
 
-		LevelInstancesArray.Add(MakeShared<FJsonValueObject>(LIInfo));
+		Values.WriteObjectEnd();
 	}
+	Values.WriteArrayEnd();
 
-	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-	ResultObj->SetBoolField(TEXT("success"), true);
-	ResultObj->SetArrayField(TEXT("actors"), ActorsArray);
-	ResultObj->SetArrayField(TEXT("level_instances"), LevelInstancesArray);
-	ResultObj->SetNumberField(TEXT("actor_count"), ActorsArray.Num());
-	ResultObj->SetNumberField(TEXT("level_instance_count"), LevelInstancesArray.Num());
-
-	return ResultObj;
+	Values.WriteValue(TEXT("actor_count"), Actors.Num());
+	Values.WriteValue(TEXT("level_instance_count"), LevelInstances.Num());
+	Writer.EndSuccess();
 }
 
 TSharedPtr<FJsonObject> FEditorCommands::HandleDeleteActor(const TSharedPtr<FJsonObject>& Params)
@@ -758,7 +817,7 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleCreateMaterial(const TSharedPtr<F
 // Actor Commands
 // ============================================================================
 
-TSharedPtr<FJsonObject> FEditorCommands::HandleSearchActors(const TSharedPtr<FJsonObject>& Params)
+void FEditorCommands::HandleSearchActors(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& Writer)
 {
 	// Get search pattern
 	FString Pattern;
@@ -785,21 +844,29 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleSearchActors(const TSharedPtr<FJs
 	UWorld* World = GEditor->GetEditorWorldContext().World();
 	if (!World)
 	{
-		return FCommonUtils::CreateErrorResponse(TEXT("No editor world available"));
+		Writer.WriteError(TEXT("No editor world available"));
+		return;
 	}
 
 	UWorldPartition* WorldPartition = GetWorldPartition();
-	TArray<TSharedPtr<FJsonValue>> ResultsArray;
 	int32 TotalFound = 0;
 	int32 LoadedCount = 0;
 	int32 UnloadedCount = 0;
 	int32 LevelInstanceActorCount = 0;
 
+	Writer.BeginSuccess();
+	FMcpItemWriter Results(Writer, TEXT("actors"));
+
 	if (WorldPartition)
 	{
 		// World Partition enabled - iterate through ActorDescInstances (UE 5.6+)
 		FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, AActor::StaticClass(), [&](const FWorldPartitionActorDescInstance* ActorDescInstance)
 		{
+			if (Results.IsCancelled())
+			{
+				return false;
+			}
+
 			if (!ActorDescInstance)
 			{
 				return true; // continue
@@ -842,12 +909,12 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleSearchActors(const TSharedPtr<FJs
 			}
 
 			// Apply limit
-			if (ResultsArray.Num() >= Limit)
+			if (Results.Num() >= Limit)
 			{
 				return true; // continue but don't add more
 			}
 
-			ResultsArray.Add(MakeShared<FJsonValueObject>(ActorDescInstanceToJson(ActorDescInstance, bIsLoaded)));
+			Results.AddItem(ActorDescInstanceToJson(ActorDescInstance, bIsLoaded));
 			return true;
 		});
 	}
@@ -856,6 +923,11 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleSearchActors(const TSharedPtr<FJs
 		// Non-WP map - use ForEachActorInWorld for Level Instance support
 		FCommonUtils::ForEachActorInWorld(World, [&](AActor* Actor, ALevelInstance* OwningLI) -> bool
 		{
+			if (Results.IsCancelled())
+			{
+				return false;
+			}
+
 			if (!Actor)
 			{
 				return true;
@@ -894,46 +966,47 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleSearchActors(const TSharedPtr<FJs
 				LevelInstanceActorCount++;
 			}
 
-			if (ResultsArray.Num() >= Limit)
+			if (Results.Num() >= Limit)
 			{
 				return true;
 			}
 
 			// Use standard actor info for non-WP maps
-			TSharedPtr<FJsonObject> ActorInfo = MakeShared<FJsonObject>();
-			ActorInfo->SetStringField(TEXT("name"), Actor->GetName());
-			ActorInfo->SetStringField(TEXT("label"), Actor->GetActorLabel());
-			ActorInfo->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-			ActorInfo->SetBoolField(TEXT("is_loaded"), true);
-
-			FVector Location = Actor->GetActorLocation();
-			TArray<TSharedPtr<FJsonValue>> LocationArray;
-			LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
-			LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
-			LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
-			ActorInfo->SetArrayField(TEXT("location"), LocationArray);
+			FMcpValueWriter& Values = Results.BeginItem();
+			Values.WriteValue(TEXT("name"), Actor->GetName());
+			Values.WriteValue(TEXT("label"), Actor->GetActorLabel());
+			Values.WriteValue(TEXT("class"), Actor->GetClass()->GetName());
+			Values.WriteValue(TEXT("is_loaded"), true);
+
+			const FVector Location = Actor->GetActorLocation();
+			Values.WriteArrayStart(TEXT("location"));
+			Values.WriteValue(Location.X);
+			Values.WriteValue(Location.Y);
+			Values.WriteValue(Location.Z);
+			Values.WriteArrayEnd();
 
 			if (OwningLI)
 			{
-				ActorInfo->SetStringField(TEXT("level_instance"), OwningLI->GetName());
-				ActorInfo->SetStringField(TEXT("level_instance_label"), OwningLI->GetActorLabel());
+				Values.WriteValue(TEXT("level_instance"), OwningLI->GetName());
+				Values.WriteValue(TEXT("level_instance_label"), OwningLI->GetActorLabel());
 			}
 
-			ResultsArray.Add(MakeShared<FJsonValueObject>(ActorInfo));
+			Results.EndItem();
 			return true;
 		}, bIncludeLevelInstances);
 	}
 
-	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-	ResultObj->SetBoolField(TEXT("success"), true);
-	ResultObj->SetBoolField(TEXT("is_world_partition"), WorldPartition != nullptr);
-	ResultObj->SetNumberField(TEXT("result_count"), ResultsArray.Num());
-	ResultObj->SetNumberField(TEXT("total_found"), TotalFound);
-	ResultObj->SetNumberField(TEXT("loaded_count"), LoadedCount);
-	ResultObj->SetNumberField(TEXT("unloaded_count"), UnloadedCount);
-	ResultObj->SetNumberField(TEXT("level_instance_actor_count"), LevelInstanceActorCount);
-	ResultObj->SetArrayField(TEXT("actors"), ResultsArray);
-	return ResultObj;
+	Results.Finish();
+
+	FMcpValueWriter& Values = Writer.Values();
+	Values.WriteValue(TEXT("success"), true);
+	Values.WriteValue(TEXT("is_world_partition"), WorldPartition != nullptr);
+	Values.WriteValue(TEXT("result_count"), Results.Num());
+	Values.WriteValue(TEXT("total_found"), TotalFound);
+	Values.WriteValue(TEXT("loaded_count"), LoadedCount);
+	Values.WriteValue(TEXT("unloaded_count"), UnloadedCount);
+	Values.WriteValue(TEXT("level_instance_actor_count"), LevelInstanceActorCount);
+	Writer.EndSuccess();
 }
 
 // ============================================================================
@@ -1741,43 +1814,154 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleLoadActorByGuid(const TSharedPtr<
 
 TSharedPtr<FJsonObject> FEditorCommands::HandleSetRegionLoaded(const TSharedPtr<FJsonObject>& Params)
 {
-	// Get loaded state
 	bool bIsLoad = true;
-	if (!Params->TryGetBoolField(TEXT("loaded"), bIsLoad))
+	FVector Center(0, 0, 0);
+	float Radius = 0.0f;
+	FString ParamError;
+	if (!ParseRegionParams(Params, bIsLoad, Center, Radius, ParamError))
+	{
+		return FCommonUtils::CreateErrorResponse(ParamError);
+	}
+
+	UWorldPartition* WorldPartition = GetWorldPartition();
+	if (!WorldPartition)
+	{
+		return FCommonUtils::CreateErrorResponse(TEXT("World Partition is not enabled for this map"));
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeRegionResult(bIsLoad, Center, Radius);
+
+	if (bIsLoad)
+	{
+		UWorld* World = GEditor->GetEditorWorldContext().World();
+		if (!World)
+		{
+			return FCommonUtils::CreateErrorResponse(TEXT("No editor world available"));
+		}
+
+		// Create a box for the region
+		FVector Extent(Radius, Radius, Radius);
+		FBox RegionBox(Center - Extent, Center + Extent);
+
+		TArray<FGuid> ActorsToLoad;
+		CollectUnloadedActorsInRegion(WorldPartition, RegionBox, ActorsToLoad);
+		const int32 LoadedCount = LoadActors(WorldPartition, ActorsToLoad);
+
+		ResultObj->SetNumberField(TEXT("actors_found"), ActorsToLoad.Num());
+		ResultObj->SetNumberField(TEXT("actors_loaded"), LoadedCount);
+		ResultObj->SetStringField(TEXT("note"), TEXT("Actors are now pinned. Use search_actors to see updated status."));
+	}
+	else
+	{
+		ResultObj->SetStringField(TEXT("note"), TEXT("Region unload requested. Actual unloading depends on editor streaming state and pin references."));
+	}
+
+	return ResultObj;
+}
+
+FMcpJobSliceFunction FEditorCommands::MakeSetRegionLoadedJob(const TSharedPtr<FJsonObject>& Params)
+{
+	struct FRegionJobState
+	{
+		bool bStarted = false;
+		TSharedPtr<FJsonObject> Result;
+		TArray<FGuid> ActorsToLoad;
+		int32 NextActor = 0;
+		int32 LoadedCount = 0;
+	};
+	TSharedPtr<FRegionJobState> State = MakeShared<FRegionJobState>();
+
+	return [this, Params, State](float& OutProgress) -> TSharedPtr<FJsonObject>
 	{
-		return FCommonUtils::CreateErrorResponse(TEXT("Missing 'loaded' parameter (true/false)."));
+		// Re-resolved every slice - the map may have changed between ticks
+		UWorldPartition* WorldPartition = GetWorldPartition();
+		if (!WorldPartition)
+		{
+			return FCommonUtils::CreateErrorResponse(TEXT("World Partition is not enabled for this map"));
+		}
+
+		if (!State->bStarted)
+		{
+			State->bStarted = true;
+
+			bool bIsLoad = true;
+			FVector Center(0, 0, 0);
+			float Radius = 0.0f;
+			FString ParamError;
+			if (!ParseRegionParams(Params, bIsLoad, Center, Radius, ParamError))
+			{
+				return FCommonUtils::CreateErrorResponse(ParamError);
+			}
+
+			// Unloading is a single request to the streaming system; only loading is worth slicing
+			if (!bIsLoad)
+			{
+				return HandleSetRegionLoaded(Params);
+			}
+
+			State->Result = MakeRegionResult(bIsLoad, Center, Radius);
+			const FVector Extent(Radius, Radius, Radius);
+			CollectUnloadedActorsInRegion(WorldPartition, FBox(Center - Extent, Center + Extent), State->ActorsToLoad);
+			OutProgress = 0.0f;
+			return nullptr;
+		}
+
+		const int32 Count = FMath::Min(MCP_REGION_LOAD_ACTORS_PER_SLICE, State->ActorsToLoad.Num() - State->NextActor);
+		State->LoadedCount += LoadActors(WorldPartition, TArrayView<const FGuid>(State->ActorsToLoad.GetData() + State->NextActor, Count));
+		State->NextActor += Count;
+
+		if (State->NextActor < State->ActorsToLoad.Num())
+		{
+			OutProgress = (float)State->NextActor / State->ActorsToLoad.Num();
+			return nullptr;
+		}
+
+		OutProgress = 1.0f;
+		State->Result->SetNumberField(TEXT("actors_found"), State->ActorsToLoad.Num());
+		State->Result->SetNumberField(TEXT("actors_loaded"), State->LoadedCount);
+		State->Result->SetStringField(TEXT("note"), TEXT("Actors are now pinned. Use search_actors to see updated status."));
+		return State->Result;
+	};
+}
+
+bool FEditorCommands::ParseRegionParams(const TSharedPtr<FJsonObject>& Params, bool& bOutLoad, FVector& OutCenter, float& OutRadius, FString& OutError)
+{
+	// Get loaded state
+	if (!Params->TryGetBoolField(TEXT("loaded"), bOutLoad))
+	{
+		OutError = TEXT("Missing 'loaded' parameter (true/false).");
+		return false;
 	}
 
 	// Get region center
-	FVector Center(0, 0, 0);
 	if (Params->HasField(TEXT("center")))
 	{
-		Center = FCommonUtils::GetVectorFromJson(Params, TEXT("center"));
+		OutCenter = FCommonUtils::GetVectorFromJson(Params, TEXT("center"));
 	}
 	else if (Params->HasField(TEXT("x")) && Params->HasField(TEXT("y")) && Params->HasField(TEXT("z")))
 	{
-		Center.X = Params->GetNumberField(TEXT("x"));
-		Center.Y = Params->GetNumberField(TEXT("y"));
-		Center.Z = Params->GetNumberField(TEXT("z"));
+		OutCenter.X = Params->GetNumberField(TEXT("x"));
+		OutCenter.Y = Params->GetNumberField(TEXT("y"));
+		OutCenter.Z = Params->GetNumberField(TEXT("z"));
 	}
 	else
 	{
-		return FCommonUtils::CreateErrorResponse(TEXT("Missing center coordinates"));
+		OutError = TEXT("Missing center coordinates");
+		return false;
 	}
 
 	// Get radius
 	if (!Params->HasField(TEXT("radius")))
 	{
-		return FCommonUtils::CreateErrorResponse(TEXT("Missing 'radius' parameter"));
-	}
-	float Radius = Params->GetNumberField(TEXT("radius"));
-
-	UWorldPartition* WorldPartition = GetWorldPartition();
-	if (!WorldPartition)
-	{
-		return FCommonUtils::CreateErrorResponse(TEXT("World Partition is not enabled for this map"));
+		OutError = TEXT("Missing 'radius' parameter");
+		return false;
 	}
+	OutRadius = Params->GetNumberField(TEXT("radius"));
+	return true;
+}
 
+TSharedPtr<FJsonObject> FEditorCommands::MakeRegionResult(bool bIsLoad, const FVector& Center, float Radius)
+{
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
 	ResultObj->SetBoolField(TEXT("loaded"), bIsLoad);
@@ -1788,64 +1972,48 @@ TSharedPtr<FJsonObject> FEditorCommands::HandleSetRegionLoaded(const TSharedPtr<
 	CenterArray.Add(MakeShared<FJsonValueNumber>(Center.Z));
 	ResultObj->SetArrayField(TEXT("center"), CenterArray);
 	ResultObj->SetNumberField(TEXT("radius"), Radius);
+	return ResultObj;
+}
 
-	if (bIsLoad)
+void FEditorCommands::CollectUnloadedActorsInRegion(UWorldPartition* WorldPartition, const FBox& RegionBox, TArray<FGuid>& OutActorGuids)
+{
+	FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, AActor::StaticClass(), [&](const FWorldPartitionActorDescInstance* ActorDescInstance) -> bool
 	{
-		UWorld* World = GEditor->GetEditorWorldContext().World();
-		if (!World)
+		if (!ActorDescInstance)
 		{
-			return FCommonUtils::CreateErrorResponse(TEXT("No editor world available"));
+			return true;
 		}
 
-		// Create a box for the region
-		FVector Extent(Radius, Radius, Radius);
-		FBox RegionBox(Center - Extent, Center + Extent);
-
-		// Collect actors in the region and load them
-		TArray<FGuid> ActorsToLoad;
-		FWorldPartitionHelpers::ForEachActorDescInstance(WorldPartition, AActor::StaticClass(), [&](const FWorldPartitionActorDescInstance* ActorDescInstance) -> bool
+		FBox ActorBounds = ActorDescInstance->GetEditorBounds();
+		if (ActorBounds.IsValid && RegionBox.Intersect(ActorBounds))
 		{
-			if (!ActorDescInstance)
-			{
-				return true;
-			}
-
-			FBox ActorBounds = ActorDescInstance->GetEditorBounds();
-			if (ActorBounds.IsValid && RegionBox.Intersect(ActorBounds))
+			if (!ActorDescInstance->GetActor())
 			{
-				if (!ActorDescInstance->GetActor())
-				{
-					ActorsToLoad.Add(ActorDescInstance->GetGuid());
-				}
+				OutActorGuids.Add(ActorDescInstance->GetGuid());
 			}
+		}
 
-			return true;
-		});
+		return true;
+	});
+}
 
-		// Load actors by creating handles/references
-		int32 LoadedCount = 0;
-		TArray<FWorldPartitionReference> LoadedRefs;
+int32 FEditorCommands::LoadActors(UWorldPartition* WorldPartition, TArrayView<const FGuid> ActorGuids)
+{
+	// Load actors by creating handles/references
+	int32 LoadedCount = 0;
+	TArray<FWorldPartitionReference> LoadedRefs;
 
-		for (const FGuid& ActorGuid : ActorsToLoad)
+	for (const FGuid& ActorGuid : ActorGuids)
+	{
+		FWorldPartitionReference Ref(WorldPartition, ActorGuid);
+		if (Ref.IsValid())
 		{
-			FWorldPartitionReference Ref(WorldPartition, ActorGuid);
-			if (Ref.IsValid())
-			{
-				LoadedRefs.Add(MoveTemp(Ref));
-				LoadedCount++;
-			}
+			LoadedRefs.Add(MoveTemp(Ref));
+			LoadedCount++;
 		}
-
-		ResultObj->SetNumberField(TEXT("actors_found"), ActorsToLoad.Num());
-		ResultObj->SetNumberField(TEXT("actors_loaded"), LoadedCount);
-		ResultObj->SetStringField(TEXT("note"), TEXT("Actors are now pinned. Use search_actors to see updated status."));
-	}
-	else
-	{
-		ResultObj->SetStringField(TEXT("note"), TEXT("Region unload requested. Actual unloading depends on editor streaming state and pin references."));
 	}
 
-	return ResultObj;
+	return LoadedCount;
 }
 
 TSharedPtr<FJsonObject> FEditorCommands::HandleGetWorldPartitionInfo(const TSharedPtr<FJsonObject>& Params)
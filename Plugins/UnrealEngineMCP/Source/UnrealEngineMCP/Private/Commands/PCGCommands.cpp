@@ -1,5 +1,6 @@
 #include "Commands/PCGCommands.h"
 #include "Commands/CommonUtils.h"
+#include "UnrealEngineMCPCommandRegistry.h"
 #include "Dom/JsonObject.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -22,71 +23,99 @@ FPCGCommands::~FPCGCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FPCGCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FPCGCommands::RegisterCommands(FMcpCommandRegistry& Registry)
 {
 	// PCG Graph asset commands
-	if (CommandType == TEXT("create_pcg_graph"))
-	{
-		return HandleCreatePCGGraph(Params);
-	}
-	else if (CommandType == TEXT("analyze_pcg_graph"))
-	{
-		return HandleAnalyzePCGGraph(Params);
-	}
-	else if (CommandType == TEXT("set_pcg_graph_to_component"))
-	{
-		return HandleSetPCGGraphToComponent(Params);
-	}
+	Registry.Add(TEXT("create_pcg_graph"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleCreatePCGGraph))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("name"), EMcpParamType::String)
+		.Optional(TEXT("path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("analyze_pcg_graph"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAnalyzePCGGraph))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("set_pcg_graph_to_component"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleSetPCGGraphToComponent))
+		.Required(TEXT("blueprint_name"), EMcpParamType::String)
+		.Required(TEXT("component_name"), EMcpParamType::String)
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("blueprint_path"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String);
+
 	// PCG node creation commands
-	else if (CommandType == TEXT("add_pcg_sampler_node"))
-	{
-		return HandleAddPCGSamplerNode(Params);
-	}
-	else if (CommandType == TEXT("add_pcg_filter_node"))
-	{
-		return HandleAddPCGFilterNode(Params);
-	}
-	else if (CommandType == TEXT("add_pcg_transform_node"))
-	{
-		return HandleAddPCGTransformNode(Params);
-	}
-	else if (CommandType == TEXT("add_pcg_spawner_node"))
-	{
-		return HandleAddPCGSpawnerNode(Params);
-	}
-	else if (CommandType == TEXT("add_pcg_attribute_node"))
-	{
-		return HandleAddPCGAttributeNode(Params);
-	}
-	else if (CommandType == TEXT("add_pcg_flow_control_node"))
-	{
-		return HandleAddPCGFlowControlNode(Params);
-	}
-	else if (CommandType == TEXT("add_pcg_generic_node"))
-	{
-		return HandleAddPCGGenericNode(Params);
-	}
+	Registry.Add(TEXT("add_pcg_sampler_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAddPCGSamplerNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("sampler_type"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("add_pcg_filter_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAddPCGFilterNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("filter_type"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("add_pcg_transform_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAddPCGTransformNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("transform_type"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("add_pcg_spawner_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAddPCGSpawnerNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("spawner_type"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("add_pcg_attribute_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAddPCGAttributeNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("attribute_type"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("add_pcg_flow_control_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAddPCGFlowControlNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("flow_type"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
+	Registry.Add(TEXT("add_pcg_generic_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleAddPCGGenericNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("node_class"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("node_position"), EMcpParamType::Array);
+
 	// PCG node list commands
-	else if (CommandType == TEXT("list_pcg_nodes"))
-	{
-		return HandleListPCGNodes(Params);
-	}
+	Registry.Add(TEXT("list_pcg_nodes"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleListPCGNodes))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String)
+		.Optional(TEXT("query"), EMcpParamType::String)
+		.Optional(TEXT("settings_class"), EMcpParamType::String);
+
 	// PCG node connection commands
-	else if (CommandType == TEXT("connect_pcg_nodes"))
-	{
-		return HandleConnectPCGNodes(Params);
-	}
-	else if (CommandType == TEXT("disconnect_pcg_nodes"))
-	{
-		return HandleDisconnectPCGNodes(Params);
-	}
-	// PCG node deletion
-	else if (CommandType == TEXT("delete_pcg_node"))
-	{
-		return HandleDeletePCGNode(Params);
-	}
+	Registry.Add(TEXT("connect_pcg_nodes"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleConnectPCGNodes))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("source_node_id"), EMcpParamType::String)
+		.Required(TEXT("target_node_id"), EMcpParamType::String)
+		.Optional(TEXT("source_pin"), EMcpParamType::String)
+		.Optional(TEXT("target_pin"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String);
+
+	Registry.Add(TEXT("disconnect_pcg_nodes"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleDisconnectPCGNodes))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Required(TEXT("pin_name"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String);
 
-	return FCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown PCG command: %s"), *CommandType));
+	// PCG node deletion
+	Registry.Add(TEXT("delete_pcg_node"), FMcpCommandDelegate::CreateRaw(this, &FPCGCommands::HandleDeletePCGNode))
+		.Required(TEXT("graph_name"), EMcpParamType::String)
+		.Required(TEXT("node_id"), EMcpParamType::String)
+		.Optional(TEXT("graph_path"), EMcpParamType::String);
 }
 
 // ============================================================================
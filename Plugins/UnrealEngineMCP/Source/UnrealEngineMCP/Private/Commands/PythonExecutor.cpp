@@ -1,5 +1,6 @@
 #include "Commands/PythonExecutor.h"
 #include "Commands/CommonUtils.h"
+#include "UnrealEngineMCPCommandRegistry.h"
 #include "Dom/JsonObject.h"
 #include "IPythonScriptPlugin.h"
 #include "Misc/FileHelper.h"
@@ -15,6 +16,14 @@ FPythonExecutor::~FPythonExecutor()
 {
 }
 
+void FPythonExecutor::RegisterCommands(FMcpCommandRegistry& Registry)
+{
+	Registry.Add(TEXT("execute_python"), FMcpCommandDelegate::CreateRaw(this, &FPythonExecutor::ExecutePython))
+		.Cost(EMcpPriority::Bulk)
+		.Async()
+		.Required(TEXT("script"), EMcpParamType::String);
+}
+
 TSharedPtr<FJsonObject> FPythonExecutor::ExecutePython(const TSharedPtr<FJsonObject>& Params)
 {
 	// Get script from params
@@ -0,0 +1,470 @@
+#include "UnrealEngineMCPBatch.h"
+#include "Commands/CommonUtils.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+namespace
+{
+	const TCHAR* StepPrefix = TEXT("$step");
+	const int32 StepPrefixLength = 5;
+
+	// Split "$stepN.path" / "$stepN[0].x" into N and the path. False if Text is not a reference.
+	bool ParseReference(const FString& Text, int32& OutStep, FString& OutPath)
+	{
+		if (!Text.StartsWith(StepPrefix, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+
+		int32 Pos = StepPrefixLength;
+		while (Pos < Text.Len() && FChar::IsDigit(Text[Pos]))
+		{
+			Pos++;
+		}
+
+		if (Pos == StepPrefixLength || Pos - StepPrefixLength > 6)
+		{
+			return false;
+		}
+
+		if (Pos < Text.Len() && Text[Pos] != TEXT('.') && Text[Pos] != TEXT('['))
+		{
+			return false;
+		}
+
+		OutStep = FCString::Atoi(*Text.Mid(StepPrefixLength, Pos - StepPrefixLength));
+		OutPath = Text.Mid(Pos);
+		OutPath.RemoveFromStart(TEXT("."));
+		return true;
+	}
+
+	TSharedPtr<FJsonValue> LookupReference(int32 Step, const FString& Path, const TArray<TSharedPtr<FJsonObject>>& StepResults, FString& OutError)
+	{
+		if (!StepResults.IsValidIndex(Step))
+		{
+			OutError = FString::Printf(TEXT("$step%d refers to a step that has not run yet"), Step);
+			return nullptr;
+		}
+
+		if (!StepResults[Step].IsValid())
+		{
+			OutError = FString::Printf(TEXT("$step%d did not succeed"), Step);
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonValue> Value = McpBatch::FindPath(StepResults[Step], Path);
+		if (!Value.IsValid())
+		{
+			OutError = FString::Printf(TEXT("$step%d has no value at '%s'"), Step, *Path);
+		}
+		return Value;
+	}
+
+	bool ValueToText(const TSharedPtr<FJsonValue>& Value, FString& OutText)
+	{
+		switch (Value->Type)
+		{
+		case EJson::String:
+			OutText = Value->AsString();
+			return true;
+		case EJson::Number:
+		{
+			const double Number = Value->AsNumber();
+			OutText = (FMath::Frac(Number) == 0.0 && FMath::Abs(Number) < 9.0e15)
+				? FString::Printf(TEXT("%lld"), (int64)Number)
+				: FString::SanitizeFloat(Number);
+			return true;
+		}
+		case EJson::Boolean:
+			OutText = Value->AsBool() ? TEXT("true") : TEXT("false");
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// "${stepN.path}" occurrences inside a longer string
+	bool InterpolateString(const FString& Text, const TArray<TSharedPtr<FJsonObject>>& StepResults, FString& OutText, FString& OutError)
+	{
+		OutText.Reset();
+		int32 Pos = 0;
+
+		while (Pos < Text.Len())
+		{
+			const int32 Start = Text.Find(TEXT("${step"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
+			const int32 End = (Start == INDEX_NONE) ? INDEX_NONE : Text.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start);
+			if (End == INDEX_NONE)
+			{
+				OutText += Text.Mid(Pos);
+				break;
+			}
+
+			OutText += Text.Mid(Pos, Start - Pos);
+
+			int32 Step = 0;
+			FString Path;
+			const FString Reference = Text.Mid(Start + 1, End - Start - 1);
+			if (!ParseReference(Reference, Step, Path))
+			{
+				OutText += Text.Mid(Start, End - Start + 1);
+				Pos = End + 1;
+				continue;
+			}
+
+			TSharedPtr<FJsonValue> Value = LookupReference(Step, Path, StepResults, OutError);
+			if (!Value.IsValid())
+			{
+				return false;
+			}
+
+			FString ValueText;
+			if (!ValueToText(Value, ValueText))
+			{
+				OutError = FString::Printf(TEXT("${%s} is not a string, number or bool"), *Reference);
+				return false;
+			}
+
+			OutText += ValueText;
+			Pos = End + 1;
+		}
+
+		return true;
+	}
+
+	// Returns Value itself when nothing inside it changes, so plain parameters are never copied
+	TSharedPtr<FJsonValue> ResolveValue(const TSharedPtr<FJsonValue>& Value, const TArray<TSharedPtr<FJsonObject>>& StepResults, FString& OutError);
+
+	TSharedPtr<FJsonObject> ResolveObject(const TSharedPtr<FJsonObject>& Object, const TArray<TSharedPtr<FJsonObject>>& StepResults, FString& OutError)
+	{
+		TSharedPtr<FJsonObject> Resolved;
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+		{
+			TSharedPtr<FJsonValue> FieldValue = ResolveValue(Field.Value, StepResults, OutError);
+			if (!FieldValue.IsValid())
+			{
+				return nullptr;
+			}
+
+			if (FieldValue != Field.Value && !Resolved.IsValid())
+			{
+				Resolved = MakeShared<FJsonObject>(*Object);
+			}
+			if (Resolved.IsValid())
+			{
+				Resolved->SetField(Field.Key, FieldValue);
+			}
+		}
+
+		return Resolved.IsValid() ? Resolved : Object;
+	}
+
+	TSharedPtr<FJsonValue> ResolveValue(const TSharedPtr<FJsonValue>& Value, const TArray<TSharedPtr<FJsonObject>>& StepResults, FString& OutError)
+	{
+		if (!Value.IsValid())
+		{
+			return MakeShared<FJsonValueNull>();
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+		{
+			const FString& Text = Value->AsString();
+			if (!Text.Contains(TEXT("$step"), ESearchCase::CaseSensitive))
+			{
+				return Value;
+			}
+
+			if (Text.StartsWith(TEXT("$$step"), ESearchCase::CaseSensitive))
+			{
+				return MakeShared<FJsonValueString>(Text.RightChop(1));
+			}
+
+			int32 Step = 0;
+			FString Path;
+			if (ParseReference(Text, Step, Path))
+			{
+				return LookupReference(Step, Path, StepResults, OutError);
+			}
+
+			FString Interpolated;
+			if (!InterpolateString(Text, StepResults, Interpolated, OutError))
+			{
+				return nullptr;
+			}
+			return (Interpolated == Text) ? Value : MakeShared<FJsonValueString>(Interpolated);
+		}
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+			TArray<TSharedPtr<FJsonValue>> ResolvedItems;
+			bool bChanged = false;
+
+			for (int32 Index = 0; Index < Items.Num(); Index++)
+			{
+				TSharedPtr<FJsonValue> Item = ResolveValue(Items[Index], StepResults, OutError);
+				if (!Item.IsValid())
+				{
+					return nullptr;
+				}
+
+				if (Item != Items[Index] && !bChanged)
+				{
+					ResolvedItems.Append(Items.GetData(), Index);
+					bChanged = true;
+				}
+				if (bChanged)
+				{
+					ResolvedItems.Add(Item);
+				}
+			}
+
+			return bChanged ? MakeShared<FJsonValueArray>(ResolvedItems) : Value;
+		}
+		case EJson::Object:
+		{
+			TSharedPtr<FJsonObject> Object = ResolveObject(Value->AsObject(), StepResults, OutError);
+			if (!Object.IsValid())
+			{
+				return nullptr;
+			}
+			return (Object == Value->AsObject()) ? Value : MakeShared<FJsonValueObject>(Object);
+		}
+		default:
+			return Value;
+		}
+	}
+}
+
+bool McpBatch::ResolveReferences(const TSharedPtr<FJsonObject>& Params, const TArray<TSharedPtr<FJsonObject>>& StepResults,
+	TSharedPtr<FJsonObject>& OutParams, FString& OutError)
+{
+	if (!Params.IsValid())
+	{
+		OutParams = Params;
+		return true;
+	}
+
+	OutParams = ResolveObject(Params, StepResults, OutError);
+	return OutParams.IsValid();
+}
+
+TSharedPtr<FJsonValue> McpBatch::FindPath(const TSharedPtr<FJsonObject>& Root, const FString& Path)
+{
+	TSharedPtr<FJsonValue> Current = MakeShared<FJsonValueObject>(Root);
+	int32 Pos = 0;
+
+	while (Pos < Path.Len() && Current.IsValid())
+	{
+		if (Path[Pos] == TEXT('['))
+		{
+			const int32 Close = Path.Find(TEXT("]"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
+			const FString IndexText = (Close == INDEX_NONE) ? FString() : Path.Mid(Pos + 1, Close - Pos - 1);
+			if (IndexText.IsEmpty() || !IndexText.IsNumeric() || Current->Type != EJson::Array)
+			{
+				return nullptr;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>& Items = Current->AsArray();
+			const int32 Index = FCString::Atoi(*IndexText);
+			Current = Items.IsValidIndex(Index) ? Items[Index] : nullptr;
+			Pos = Close + 1;
+		}
+		else
+		{
+			if (Path[Pos] == TEXT('.'))
+			{
+				Pos++;
+			}
+
+			int32 End = Pos;
+			while (End < Path.Len() && Path[End] != TEXT('.') && Path[End] != TEXT('['))
+			{
+				End++;
+			}
+
+			if (End == Pos || Current->Type != EJson::Object)
+			{
+				return nullptr;
+			}
+
+			Current = Current->AsObject()->TryGetField(Path.Mid(Pos, End - Pos));
+			Pos = End;
+		}
+	}
+
+	return Current;
+}
+
+FMcpBatchTransaction::FMcpBatchTransaction(const FString& Description)
+	: bOpen(false)
+{
+	if (!GEditor)
+	{
+		return;
+	}
+
+	GEditor->BeginTransaction(TEXT("UnrealEngineMCP"), FText::FromString(Description), nullptr);
+	bOpen = true;
+	FCommonUtils::BeginDeferredCompilation();
+
+	// Spawned and deleted actors change the level's actor list. This also guarantees the
+	// transaction is never empty, so Rollback always undoes this transaction and not an earlier one.
+	if (UWorld* World = GEditor->GetEditorWorldContext().World())
+	{
+		CaptureObject(World->PersistentLevel);
+	}
+}
+
+FMcpBatchTransaction::~FMcpBatchTransaction()
+{
+	if (bOpen)
+	{
+		Rollback();
+	}
+}
+
+void FMcpBatchTransaction::CaptureTargets(const TSharedPtr<FJsonObject>& Params)
+{
+	if (!bOpen || !Params.IsValid())
+	{
+		return;
+	}
+
+	FString BlueprintName;
+	if (Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName) && !BlueprintName.IsEmpty())
+	{
+		FString BlueprintPath = TEXT("/Game/Blueprints/");
+		Params->TryGetStringField(TEXT("blueprint_path"), BlueprintPath);
+		CaptureBlueprint(FCommonUtils::FindBlueprint(BlueprintName, BlueprintPath));
+	}
+
+	if (UWorld* World = GEditor->GetEditorWorldContext().World())
+	{
+		for (const TCHAR* Field : { TEXT("name"), TEXT("actor_name") })
+		{
+			FString ActorName;
+			if (Params->TryGetStringField(Field, ActorName) && !ActorName.IsEmpty())
+			{
+				if (AActor* Actor = FCommonUtils::FindActorByName(World, ActorName))
+				{
+					CaptureObject(Actor);
+					for (UActorComponent* Component : Actor->GetComponents())
+					{
+						CaptureObject(Component);
+					}
+				}
+			}
+		}
+	}
+
+	for (const TCHAR* Field : { TEXT("asset_path"), TEXT("graph_path") })
+	{
+		FString AssetPath;
+		if (Params->TryGetStringField(Field, AssetPath) && !AssetPath.IsEmpty())
+		{
+			// Creation commands name assets that do not exist yet
+			UObject* Asset = StaticLoadObject(UObject::StaticClass(), nullptr, *AssetPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+			if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+			{
+				CaptureBlueprint(Blueprint);
+			}
+			else
+			{
+				CaptureObject(Asset);
+			}
+		}
+	}
+}
+
+void FMcpBatchTransaction::CaptureObject(UObject* Object)
+{
+	if (Object && !Captured.Contains(Object))
+	{
+		Captured.Add(Object);
+		Object->Modify();
+	}
+}
+
+void FMcpBatchTransaction::CaptureBlueprint(UBlueprint* Blueprint)
+{
+	if (!Blueprint || Captured.Contains(Blueprint))
+	{
+		return;
+	}
+
+	// Nodes hold their pin links, so existing nodes are recorded too; nodes added later in the
+	// batch are new objects and simply drop out of the restored graphs
+	CaptureObject(Blueprint);
+	CapturedBlueprints.Add(Blueprint);
+
+	for (UEdGraph* Graph : FCommonUtils::GetAllGraphs(Blueprint))
+	{
+		CaptureObject(Graph);
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			CaptureObject(Node);
+		}
+	}
+
+	if (USimpleConstructionScript* SCS = Blueprint->SimpleConstructionScript)
+	{
+		CaptureObject(SCS);
+		for (USCS_Node* Node : SCS->GetAllNodes())
+		{
+			CaptureObject(Node);
+			CaptureObject(Node ? Node->ComponentTemplate : nullptr);
+		}
+	}
+}
+
+TArray<FString> FMcpBatchTransaction::Commit()
+{
+	TArray<FString> Compiled;
+	if (!bOpen)
+	{
+		return Compiled;
+	}
+
+	GEditor->EndTransaction();
+	bOpen = false;
+
+	for (UBlueprint* Blueprint : FCommonUtils::EndDeferredCompilation())
+	{
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+		Compiled.Add(Blueprint->GetName());
+	}
+	return Compiled;
+}
+
+void FMcpBatchTransaction::Rollback()
+{
+	if (!bOpen)
+	{
+		return;
+	}
+
+	// The undone edits need no compile
+	FCommonUtils::EndDeferredCompilation();
+
+	GEditor->EndTransaction();
+	GEditor->UndoTransaction(false);
+	bOpen = false;
+
+	// A step may have compiled before the failure; refresh the restored blueprints' classes
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : CapturedBlueprints)
+	{
+		if (Blueprint.IsValid())
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint.Get());
+		}
+	}
+}
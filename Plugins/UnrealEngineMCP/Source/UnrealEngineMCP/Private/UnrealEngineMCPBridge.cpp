@@ -1,15 +1,19 @@
 #include "UnrealEngineMCPBridge.h"
 #include "UnrealEngineMCPRunnable.h"
+#include "UnrealEngineMCPConnectionManager.h"
+#include "UnrealEngineMCPConnection.h"
+#include "UnrealEngineMCPTransport.h"
+#include "UnrealEngineMCPBatch.h"
 #include "Commands/EditorCommands.h"
 #include "Commands/BlueprintCommands.h"
 #include "Commands/PCGCommands.h"
 #include "Commands/PythonExecutor.h"
-#include "Sockets.h"
-#include "SocketSubsystem.h"
+#include "Commands/CommonUtils.h"
 #include "HAL/RunnableThread.h"
 #include "HAL/PlatformTime.h"
+#include "Async/Async.h"
+#include "UObject/GarbageCollection.h"
 #include "Interfaces/IPv4/IPv4Address.h"
-#include "Interfaces/IPv4/IPv4Endpoint.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonReader.h"
@@ -17,16 +21,66 @@
 
 #define MCP_SERVER_HOST "127.0.0.1"
 #define MCP_SERVER_PORT 55557
-#define MCP_MAX_COMMANDS_PER_TICK 10
-#define MCP_MAX_QUEUE_SIZE 50
+#define MCP_TICK_BUDGET_MS 8.0
+#define MCP_MAX_COMMANDS_PER_TICK 256  // Upper bound even when every command is cheap
+#define MCP_COST_SMOOTHING 0.2         // Weight of the newest sample in a command's cost estimate
+#define MCP_MAX_QUEUE_SIZE 50  // Floor; raised to cover every connection's in-flight window
+#define MCP_MAX_CONNECTIONS 8
+#define MCP_MAX_BATCH_COMMANDS 256
+#define MCP_MAX_WORKER_COMMANDS 4
+#define MCP_RESPONSE_TTL_SECONDS 30.0       // Finished responses nobody collects are released after this
+#define MCP_RESPONSE_SWEEP_INTERVAL 1.0
+
+namespace
+{
+	// Blueprint classes can be recompiled underneath a reader, so class reflection only runs off the
+	// game thread for native classes. Names that do not resolve go to the game thread, which may load them.
+	// Decided before dispatch, so a request never has to come back from a worker.
+	bool CanRunOffGameThread(const FMcpCommandRequest& Request)
+	{
+		if (!Request.Command || Request.Command->Affinity != EMcpThreadAffinity::AnyThread)
+		{
+			return false;
+		}
+
+		// Only the Asset Registry part of a search is safe; class search walks every loaded UClass and
+		// base_class resolves classes, including Blueprint ones being compiled or reinstanced
+		if (Request.CommandType == TEXT("search_assets"))
+		{
+			FString SearchScope;
+			Request.Params->TryGetStringField(TEXT("search_scope"), SearchScope);
+			return SearchScope == TEXT("asset") && !Request.Params->HasField(TEXT("base_class"));
+		}
+
+		if (Request.CommandType != TEXT("get_class_functions") && Request.CommandType != TEXT("get_class_properties"))
+		{
+			return true;
+		}
+
+		FString ClassName;
+		if (!Request.Params->TryGetStringField(TEXT("class_name"), ClassName))
+		{
+			return true;
+		}
+
+		FGCScopeGuard GCGuard;
+		const UClass* Class = FCommonUtils::FindClassByName(ClassName);
+		return Class && Class->HasAnyClassFlags(CLASS_Native);
+	}
+}
 
 UUnrealEngineMCPBridge::UUnrealEngineMCPBridge()
 	: bIsRunning(false)
-	, ListenerSocket(nullptr)
-	, ServerThread(nullptr)
 	, Port(MCP_SERVER_PORT)
+	, MaxConnections(MCP_MAX_CONNECTIONS)
+	, MaxQueuedCommands(MCP_MAX_QUEUE_SIZE)
+	, TickBudgetSeconds(MCP_TICK_BUDGET_MS / 1000.0)
+	, MaxWorkerCommands(MCP_MAX_WORKER_COMMANDS)
+	, ResponseTtlSeconds(MCP_RESPONSE_TTL_SECONDS)
+	, LastResponseSweepTime(0.0)
 	, NextRequestId(1)
 	, PendingCommandCount(0)
+	, ActiveWorkerCommands(0)
 {
 	EditorCommandHandler = MakeShared<FEditorCommands>();
 	BlueprintCommandHandler = MakeShared<FBlueprintCommands>();
@@ -36,6 +90,8 @@ UUnrealEngineMCPBridge::UUnrealEngineMCPBridge()
 
 UUnrealEngineMCPBridge::~UUnrealEngineMCPBridge()
 {
+	// Registered delegates point into the handlers
+	Commands.Reset();
 	EditorCommandHandler.Reset();
 	BlueprintCommandHandler.Reset();
 	PCGCommandHandler.Reset();
@@ -47,8 +103,6 @@ void UUnrealEngineMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Initializing with Command Queue pattern"));
 
 	bIsRunning = false;
-	ListenerSocket = nullptr;
-	ServerThread = nullptr;
 	PendingCommandCount = 0;
 
 	Port = MCP_SERVER_PORT;
@@ -59,11 +113,112 @@ void UUnrealEngineMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 		UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Port overridden to %d"), Port);
 	}
 
+	MaxConnections = MCP_MAX_CONNECTIONS;
+	FString MaxConnectionsStr;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-McpMaxConnections="), MaxConnectionsStr))
+	{
+		MaxConnections = FMath::Max(1, FCString::Atoi(*MaxConnectionsStr));
+		UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Max connections overridden to %d"), MaxConnections);
+	}
+
+	// Connections already stop reading at their in-flight limit, so work they were allowed to send is never rejected
+	MaxQueuedCommands = FMath::Max(MCP_MAX_QUEUE_SIZE, MCP_MAX_INFLIGHT_PER_CONNECTION * MaxConnections);
+
+	// Same-machine clients skip the loopback TCP stack through a Unix domain socket where available
+	LocalSocketPath.Empty();
+	if (MCP_WITH_LOCAL_SOCKET && !FParse::Param(FCommandLine::Get(), TEXT("McpNoLocalSocket")))
+	{
+		LocalSocketPath = McpTransport::GetDefaultLocalSocketPath(Port);
+		if (FParse::Value(FCommandLine::Get(), TEXT("-McpLocalSocket="), LocalSocketPath))
+		{
+			UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Local socket path overridden to %s"), *LocalSocketPath);
+		}
+	}
+
+	TickBudgetSeconds = MCP_TICK_BUDGET_MS / 1000.0;
+	FString TickBudgetStr;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-McpTickBudgetMs="), TickBudgetStr))
+	{
+		TickBudgetSeconds = FMath::Max(0.1, FCString::Atod(*TickBudgetStr)) / 1000.0;
+		UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Tick budget overridden to %.1f ms"), TickBudgetSeconds * 1000.0);
+	}
+
+	MaxWorkerCommands = MCP_MAX_WORKER_COMMANDS;
+	FString MaxWorkerCommandsStr;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-McpWorkerCommands="), MaxWorkerCommandsStr))
+	{
+		MaxWorkerCommands = FMath::Max(0, FCString::Atoi(*MaxWorkerCommandsStr));
+		UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Worker commands overridden to %d"), MaxWorkerCommands);
+	}
+
+	ResponseTtlSeconds = MCP_RESPONSE_TTL_SECONDS;
+	FString ResponseTtlStr;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-McpResponseTtl="), ResponseTtlStr))
+	{
+		ResponseTtlSeconds = FMath::Max(1.0, FCString::Atod(*ResponseTtlStr));
+		UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Response TTL overridden to %.0f s"), ResponseTtlSeconds);
+	}
+
+	const bool bResponseCacheDisabled = FParse::Param(FCommandLine::Get(), TEXT("McpNoResponseCache"));
+	ResponseCache.SetEnabled(!bResponseCacheDisabled);
+	if (bResponseCacheDisabled)
+	{
+		UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Response cache disabled"));
+	}
+
 	FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
 
+	RegisterCommands();
 	StartServer();
 }
 
+void UUnrealEngineMCPBridge::RegisterCommands()
+{
+	Commands.Reset();
+
+	Commands.Add(TEXT("ping"), FMcpCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandlePing))
+		.ReadOnly();
+	Commands.Add(TEXT("list_connections"), FMcpCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandleListConnections))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly);
+	Commands.Add(TEXT("list_commands"), FMcpCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandleListCommands))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly);
+	Commands.Add(TEXT("get_server_stats"), FMcpCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandleGetServerStats))
+		.ReadOnly()
+		.ThreadSafe()
+		.Optional(TEXT("command"), EMcpParamType::String)
+		.Optional(TEXT("reset"), EMcpParamType::Boolean);
+
+	// Job control only touches the job table, which has its own lock, and never the editor itself.
+	// Cancelling changes a job, so a retried cancel_job with an idempotency key replays the first answer.
+	Commands.Add(TEXT("job_status"), FMcpCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandleJobStatus))
+		.ReadOnly()
+		.ThreadSafe()
+		.Required(TEXT("job_id"), EMcpParamType::String);
+	Commands.Add(TEXT("cancel_job"), FMcpCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandleCancelJob))
+		.BridgeStateOnly()
+		.ThreadSafe()
+		.Required(TEXT("job_id"), EMcpParamType::String);
+	Commands.Add(TEXT("list_jobs"), FMcpCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandleListJobs))
+		.ReadOnly()
+		.Cost(EMcpPriority::ReadOnly)
+		.ThreadSafe();
+
+	Commands.Add(TEXT("batch"), FMcpStreamingCommandDelegate::CreateUObject(this, &UUnrealEngineMCPBridge::HandleBatch))
+		.Cost(EMcpPriority::Bulk)
+		.Required(TEXT("commands"), EMcpParamType::Array)
+		.Optional(TEXT("stop_on_error"), EMcpParamType::Boolean)
+		.Optional(TEXT("transaction"), EMcpParamType::Boolean);
+
+	EditorCommandHandler->RegisterCommands(Commands);
+	BlueprintCommandHandler->RegisterCommands(Commands);
+	PCGCommandHandler->RegisterCommands(Commands);
+	PythonExecutorHandler->RegisterCommands(Commands);
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Registered %d commands"), Commands.Num());
+}
+
 void UUnrealEngineMCPBridge::Deinitialize()
 {
 	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Shutting down"));
@@ -75,292 +230,884 @@ void UUnrealEngineMCPBridge::Tick(float DeltaTime)
 	if (bIsRunning)
 	{
 		ProcessCommandQueue();
+
+		// After the commands, so changes they made go out this tick
+		Events->Flush();
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastResponseSweepTime >= MCP_RESPONSE_SWEEP_INTERVAL)
+		{
+			ExpireUnclaimedResponses(Now);
+			LastResponseSweepTime = Now;
+		}
 	}
 }
 
 void UUnrealEngineMCPBridge::ProcessCommandQueue()
 {
-	FMcpCommandRequest Request;
+	// Commands run until the frame's time budget is spent. A command whose measured cost would
+	// overrun what is left waits for the next tick; the first command of a tick always runs,
+	// so an expensive command is delayed at most one frame and never starved.
+	const double TickStartTime = FPlatformTime::Seconds();
 	int32 ProcessedCount = 0;
 
-	while (CommandQueue.Dequeue(Request) && ProcessedCount < MCP_MAX_COMMANDS_PER_TICK)
+	// Sort new arrivals into their priority lanes
+	FMcpCommandRequest Incoming;
+	while (CommandQueue.Dequeue(Incoming))
+	{
+		Scheduler.Push(MoveTemp(Incoming));
+	}
+
+	while (ProcessedCount < MCP_MAX_COMMANDS_PER_TICK)
 	{
+		const double Now = FPlatformTime::Seconds();
+		const FMcpCommandRequest* Next = Scheduler.Peek(Now, [this](const FMcpCommandRequest& Head)
+		{
+			return CanStartOnGameThread(Head);
+		});
+		if (!Next)
+		{
+			break;
+		}
+
+		if (ProcessedCount > 0 && (Now - TickStartTime) + EstimateCommandCost(Next->CommandType) > TickBudgetSeconds)
+		{
+			break;
+		}
+
+		FMcpCommandRequest Request;
+		Scheduler.Pop(Request);
+		const uint32 ConnectionId = Request.ConnectionId;
+
+		// Everything the connection sent before it has finished, so a read may now run beside the game thread
+		if (TryStartOnWorker(Request, true))
+		{
+			ExecuteOnWorker(MoveTemp(Request));
+			continue;
+		}
+
 		PendingCommandCount--;
 
-		FString Response = ExecuteCommandInternal(Request.CommandType, Request.Params);
+		if (DiscardIfCancelled(Request))
+		{
+			ReleaseRequest(ConnectionId, false);
+			continue;
+		}
 
+		const double CommandStartTime = FPlatformTime::Seconds();
+		FMcpResponseWriter ResponseWriter(Request.Stream, Request.Encoding, Request.Cancellation);
+		if (ExecuteRequest(Request, ResponseWriter))
 		{
-			FScopeLock Lock(&ResponseMapLock);
-			ResponseMap.Add(Request.RequestId, FMcpCommandResponse(Request.RequestId, Response, true));
+			RecordCommandCost(Request.CommandType, FPlatformTime::Seconds() - CommandStartTime);
 		}
 
+		CompleteRequest(Request, ResponseWriter);
+		ReleaseRequest(ConnectionId, false);
 		ProcessedCount++;
 	}
+
+	// Jobs get what is left of the budget, and at least one slice per tick
+	Jobs.Tick(TickStartTime + TickBudgetSeconds);
+}
+
+void UUnrealEngineMCPBridge::ExecuteOnWorker(FMcpCommandRequest&& Request)
+{
+	Async(EAsyncExecution::ThreadPool, [this, Request = MoveTemp(Request)]() mutable
+	{
+		if (DiscardIfCancelled(Request))
+		{
+			PendingCommandCount--;
+			ReleaseRequest(Request.ConnectionId, true);
+			ActiveWorkerCommands--;
+			return;
+		}
+
+		FMcpResponseWriter ResponseWriter(Request.Stream, Request.Encoding, Request.Cancellation);
+		{
+			// Reflection and registry reads must not overlap garbage collection
+			FGCScopeGuard GCGuard;
+			ExecuteRequest(Request, ResponseWriter);
+		}
+
+		// Released before the response goes out, so what the client sends once it has it is not held back
+		PendingCommandCount--;
+		ReleaseRequest(Request.ConnectionId, true);
+		CompleteRequest(Request, ResponseWriter);
+		ActiveWorkerCommands--;
+	});
+}
+
+void UUnrealEngineMCPBridge::CompleteRequest(const FMcpCommandRequest& Request, FMcpResponseWriter& ResponseWriter)
+{
+	if (Request.Cancellation.IsValid() && Request.Cancellation->IsAbandoned())
+	{
+		// An abandon racing past this check is harmless: the slot goes away with its last reference
+		Request.ResponseSlot->Discard();
+		return;
+	}
+
+	Request.ResponseSlot->Fulfil(ResponseWriter.MoveBody());
+	FulfilledSlots.Enqueue(Request.ResponseSlot);
+
+	if (Request.CompletionSignal.IsValid())
+	{
+		Request.CompletionSignal->Trigger();
+	}
+}
+
+bool UUnrealEngineMCPBridge::DiscardIfCancelled(const FMcpCommandRequest& Request)
+{
+	if (!Request.Cancellation.IsValid() || !Request.Cancellation->IsCancelled())
+	{
+		return false;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Discarding cancelled command before execution: %s"), *Request.CommandType);
+
+	// Discarded by CompleteRequest if the client has gone away
+	FMcpResponseWriter ResponseWriter(nullptr, Request.Encoding);
+	ResponseWriter.WriteError(Request.Cancellation->IsPastDeadline() ? TEXT("Deadline exceeded") : TEXT("Cancelled"));
+	CompleteRequest(Request, ResponseWriter);
+	return true;
+}
+
+double UUnrealEngineMCPBridge::EstimateCommandCost(const FString& CommandType) const
+{
+	// Unmeasured commands are assumed cheap; one sample is enough to correct that
+	const double* Cost = CommandCostSeconds.Find(CommandType);
+	return Cost ? *Cost : 0.0;
+}
+
+void UUnrealEngineMCPBridge::RecordCommandCost(const FString& CommandType, double Seconds)
+{
+	double* Cost = CommandCostSeconds.Find(CommandType);
+	if (Cost)
+	{
+		*Cost += (Seconds - *Cost) * MCP_COST_SMOOTHING;
+	}
+	else
+	{
+		CommandCostSeconds.Add(CommandType, Seconds);
+	}
 }
 
-bool UUnrealEngineMCPBridge::EnqueueCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, uint32& OutRequestId)
+FMcpResponseSlotPtr UUnrealEngineMCPBridge::EnqueueCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, uint32& OutRequestId,
+	FMcpCompletionSignalPtr CompletionSignal, FMcpResponseStreamPtr Stream, EMcpEncoding Encoding, uint32 ConnectionId,
+	FMcpCancellationTokenPtr Cancellation, const FString& IdempotencyKey)
 {
-	if (PendingCommandCount.Load() >= MCP_MAX_QUEUE_SIZE)
+	if (PendingCommandCount.Load() >= MaxQueuedCommands)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("UnrealEngineMCPBridge: Queue full (%d), rejecting: %s"),
 			PendingCommandCount.Load(), *CommandType);
-		return false;
+		ServerStats.RecordRejected(Commands.Find(CommandType));
+		return nullptr;
 	}
 
 	OutRequestId = NextRequestId++;
-	CommandQueue.Enqueue(FMcpCommandRequest(OutRequestId, CommandType, Params));
-	PendingCommandCount++;
-	return true;
+	FMcpCommandRequest Request(OutRequestId, CommandType, Params, CompletionSignal, Stream, Encoding, ConnectionId, Cancellation, IdempotencyKey);
+	Request.Command = Commands.Find(CommandType);
+	Request.bAnyThread = CanRunOffGameThread(Request);
+	FMcpResponseSlotPtr ResponseSlot = Request.ResponseSlot;
+	ServerStats.RecordEnqueued(++PendingCommandCount);
+
+	// Thread-safe queries skip the game thread and run in parallel with each other, unless they
+	// would overtake an earlier request of the same connection; those go through the scheduler,
+	// which hands them to the pool once they reach the head of the connection's queue
+	if (TryStartOnWorker(Request, false))
+	{
+		ExecuteOnWorker(MoveTemp(Request));
+	}
+	else
+	{
+		EnqueueForGameThread(MoveTemp(Request));
+	}
+	return ResponseSlot;
 }
 
-bool UUnrealEngineMCPBridge::TryDequeueResponse(uint32 RequestId, FMcpCommandResponse& OutResponse)
+bool UUnrealEngineMCPBridge::TryStartOnWorker(const FMcpCommandRequest& Request, bool bQueued)
 {
-	FScopeLock Lock(&ResponseMapLock);
+	if (!Request.bAnyThread)
+	{
+		return false;
+	}
 
-	if (FMcpCommandResponse* Found = ResponseMap.Find(RequestId))
+	FScopeLock Lock(&OutstandingRequestsLock);
+	FOutstandingRequests& Outstanding = OutstandingRequests.FindOrAdd(Request.ConnectionId);
+	// At the head of the scheduler everything sent before it has finished; requests behind it do not matter
+	if (!bQueued && Outstanding.GameThread > 0)
+	{
+		return false;
+	}
+
+	// Pool saturated: the game thread is still a correct place to run it
+	if (++ActiveWorkerCommands > MaxWorkerCommands)
+	{
+		ActiveWorkerCommands--;
+		if (Outstanding.GameThread == 0 && Outstanding.Worker == 0)
+		{
+			OutstandingRequests.Remove(Request.ConnectionId);
+		}
+		return false;
+	}
+
+	Outstanding.Worker++;
+	if (bQueued)
+	{
+		Outstanding.GameThread--;
+	}
+	return true;
+}
+
+bool UUnrealEngineMCPBridge::CanStartOnGameThread(const FMcpCommandRequest& Request) const
+{
+	// Reads may run beside the connection's earlier reads; anything else waits for them
+	if (Request.bAnyThread)
 	{
-		OutResponse = *Found;
-		ResponseMap.Remove(RequestId);
 		return true;
 	}
-	return false;
+
+	FScopeLock Lock(&OutstandingRequestsLock);
+	const FOutstandingRequests* Outstanding = OutstandingRequests.Find(Request.ConnectionId);
+	return !Outstanding || Outstanding->Worker == 0;
+}
+
+void UUnrealEngineMCPBridge::EnqueueForGameThread(FMcpCommandRequest&& Request)
+{
+	{
+		FScopeLock Lock(&OutstandingRequestsLock);
+		OutstandingRequests.FindOrAdd(Request.ConnectionId).GameThread++;
+	}
+	CommandQueue.Enqueue(MoveTemp(Request));
 }
 
-bool UUnrealEngineMCPBridge::WaitForResponse(uint32 RequestId, FMcpCommandResponse& OutResponse, float TimeoutSeconds)
+void UUnrealEngineMCPBridge::ReleaseRequest(uint32 ConnectionId, bool bOnWorker)
 {
-	double StartTime = FPlatformTime::Seconds();
+	FScopeLock Lock(&OutstandingRequestsLock);
+	FOutstandingRequests* Outstanding = OutstandingRequests.Find(ConnectionId);
+	if (!Outstanding)
+	{
+		return;
+	}
 
-	while ((FPlatformTime::Seconds() - StartTime) < TimeoutSeconds)
+	(bOnWorker ? Outstanding->Worker : Outstanding->GameThread)--;
+	if (Outstanding->GameThread <= 0 && Outstanding->Worker <= 0)
 	{
-		if (TryDequeueResponse(RequestId, OutResponse))
+		OutstandingRequests.Remove(ConnectionId);
+	}
+}
+
+void UUnrealEngineMCPBridge::ExpireUnclaimedResponses(double Now)
+{
+	FMcpResponseSlotWeakPtr Fulfilled;
+	while (FulfilledSlots.Dequeue(Fulfilled))
+	{
+		UnclaimedSlots.Add(MoveTemp(Fulfilled));
+	}
+
+	// Only this sweep expires slots
+	const int32 ExpiredBefore = FMcpResponseSlot::GetExpiredCount();
+	UnclaimedSlots.RemoveAll([Cutoff = Now - ResponseTtlSeconds](const FMcpResponseSlotWeakPtr& WeakSlot)
+	{
+		// Most slots are collected within a tick and already gone
+		FMcpResponseSlotPtr Slot = WeakSlot.Pin();
+		return !Slot.IsValid() || Slot->ExpireIfOlderThan(Cutoff);
+	});
+
+	const int32 ExpiredCount = FMcpResponseSlot::GetExpiredCount() - ExpiredBefore;
+	if (ExpiredCount > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealEngineMCPBridge: Released %d response(s) unclaimed for %.0f s"), ExpiredCount, ResponseTtlSeconds);
+	}
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::GetResponseStatsJson() const
+{
+	TSharedPtr<FJsonObject> StatsObj = MakeShared<FJsonObject>();
+	StatsObj->SetNumberField(TEXT("outstanding"), FMcpResponseSlot::GetOutstandingCount());
+	StatsObj->SetNumberField(TEXT("unclaimed"), FMcpResponseSlot::GetUnclaimedCount());
+	StatsObj->SetNumberField(TEXT("expired"), FMcpResponseSlot::GetExpiredCount());
+	StatsObj->SetNumberField(TEXT("discarded"), FMcpResponseSlot::GetDiscardedCount());
+	StatsObj->SetNumberField(TEXT("ttl_seconds"), ResponseTtlSeconds);
+	StatsObj->SetNumberField(TEXT("idempotent_stored"), IdempotentResults.Num());
+	StatsObj->SetNumberField(TEXT("idempotent_replays"), IdempotentResults.GetReplayCount());
+	return StatsObj;
+}
+
+bool UUnrealEngineMCPBridge::ExecuteRequest(const FMcpCommandRequest& Request, FMcpResponseWriter& ResponseWriter)
+{
+	// Includes time spent waiting for a tick, in a scheduler lane and behind the tick budget
+	const double QueueSeconds = FPlatformTime::Seconds() - Request.Timestamp;
+
+	// Reads are cheap to repeat, or cached below, and would only crowd mutations out of the cache
+	const bool bRemember = !Request.IdempotencyKey.IsEmpty() && Request.Command && !Request.Command->bReadOnly;
+	const FString CacheKey = bRemember ? Request.CommandType + TEXT(":") + Request.IdempotencyKey : FString();
+
+	if (bRemember)
+	{
+		FMcpResponseBody StoredBody;
+		EMcpEncoding StoredEncoding;
+		if (IdempotentResults.Find(CacheKey, StoredBody, StoredEncoding))
 		{
-			return true;
+			UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Replaying stored response for %s (idempotency key %s)"),
+				*Request.CommandType, *Request.IdempotencyKey);
+
+			if (StoredEncoding == Request.Encoding)
+			{
+				ResponseWriter.ReplaceBody(MoveTemp(StoredBody));
+			}
+			else
+			{
+				// Never run it again just because the retry came in over a differently negotiated connection
+				ResponseWriter.WriteError(FString::Printf(TEXT("Idempotency key was already used with %s encoding; retry with the same encoding"),
+					McpEncoding::ToString(StoredEncoding)));
+			}
+			ServerStats.RecordExecution(Request.Command, QueueSeconds, 0.0, 0.0, false, ResponseWriter.HasError());
+			return false;
 		}
-		FPlatformProcess::Sleep(0.001f);  // 1ms sleep
 	}
 
-	return false;
+	FMcpResponseBody CachedBody;
+	FMcpResponseCache::FTicket CacheTicket;
+	if (ResponseCache.Find(Request.CommandType, Request.Params, Request.Encoding, Request.Stream.IsValid(), CachedBody, CacheTicket))
+	{
+		ResponseWriter.ReplaceBody(MoveTemp(CachedBody));
+		ServerStats.RecordExecution(Request.Command, QueueSeconds, 0.0, 0.0, false, false);
+		return false;
+	}
+
+	const double ExecuteStartTime = FPlatformTime::Seconds();
+	ExecuteCommandInternal(Request.CommandType, Request.Params, ResponseWriter);
+	const double SerializeSeconds = ResponseWriter.GetSerializeSeconds();
+	ServerStats.RecordExecution(Request.Command, QueueSeconds, FPlatformTime::Seconds() - ExecuteStartTime - SerializeSeconds, SerializeSeconds,
+		true, ResponseWriter.HasError());
+	if (Request.Command && !Request.Command->bReadOnly && !Request.Command->bBridgeStateOnly)
+	{
+		ResponseCache.NoteCommandExecuted(Request.CommandType, Request.Params);
+	}
+
+	// A handler that stopped early on cancellation left the work unfinished, so a retry should run it
+	if (bRemember && !ResponseWriter.WasCancellationObserved())
+	{
+		IdempotentResults.Store(CacheKey, ResponseWriter.GetBody(), Request.Encoding);
+	}
+
+	// Errors often mean "not there yet", which the next request should look at again
+	if (CacheTicket.IsValid() && !ResponseWriter.HasError() && !ResponseWriter.WasCancellationObserved())
+	{
+		ResponseCache.Store(CacheTicket, ResponseWriter.GetBody());
+	}
+	return true;
 }
 
-FString UUnrealEngineMCPBridge::ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void UUnrealEngineMCPBridge::Subscribe(const FMcpResponseStreamPtr& Stream, EMcpEventTopic Topics, EMcpEncoding Encoding)
 {
-	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Executing command: %s"), *CommandType);
+	// Connections only exist while the server runs, and the hub outlives them
+	Events->Subscribe(Stream, Topics, Encoding);
+}
 
-	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+void UUnrealEngineMCPBridge::Unsubscribe(const FMcpResponseStreamPtr& Stream)
+{
+	Events->Unsubscribe(Stream);
+}
+
+void UUnrealEngineMCPBridge::ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& ResponseWriter)
+{
+	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Executing command: %s"), *CommandType);
 
 	try
 	{
 		TSharedPtr<FJsonObject> ResultJson;
+		if (!DispatchCommand(CommandType, Params, ResponseWriter, ResultJson))
+		{
+			ResponseWriter.WriteError(FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+			return;
+		}
+
+		if (ResultJson.IsValid())
+		{
+			ResponseWriter.WriteResponse(MakeEnvelope(ResultJson));
+		}
+	}
+	catch (const std::exception& e)
+	{
+		ResponseWriter.WriteError(UTF8_TO_TCHAR(e.what()));
+	}
+}
 
-		if (CommandType == TEXT("ping"))
-		{
-			ResultJson = MakeShared<FJsonObject>();
-			ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-			ResultJson->SetBoolField(TEXT("success"), true);
-		}
-		else if (CommandType == TEXT("execute_python"))
-		{
-			ResultJson = PythonExecutorHandler->ExecutePython(Params);
-		}
-		else if (CommandType == TEXT("spawn_actor") ||
-				 CommandType == TEXT("list_level_actors") ||
-				 CommandType == TEXT("delete_actor") ||
-				 CommandType == TEXT("set_actor_transform") ||
-				 CommandType == TEXT("get_actor_properties") ||
-				 CommandType == TEXT("set_actor_property") ||
-				 CommandType == TEXT("spawn_blueprint_actor") ||
-				 CommandType == TEXT("create_material") ||
-				 CommandType == TEXT("search_actors") ||
-				 CommandType == TEXT("apply_material_to_actor") ||
-				 CommandType == TEXT("get_actor_material_info") ||
-				 CommandType == TEXT("search_assets") ||
-				 CommandType == TEXT("list_folder_assets") ||
-				 CommandType == TEXT("get_world_partition_info") ||
-				 CommandType == TEXT("search_actors_in_region") ||
-				 CommandType == TEXT("load_actor_by_guid") ||
-				 CommandType == TEXT("set_region_loaded") ||
-				 CommandType == TEXT("list_level_instances") ||
-				 CommandType == TEXT("get_level_instance_actors") ||
-				 CommandType == TEXT("list_gameplay_tags"))
-		{
-			ResultJson = EditorCommandHandler->HandleCommand(CommandType, Params);
-		}
-		else if (CommandType == TEXT("create_blueprint") ||
-				 CommandType == TEXT("add_component_to_blueprint") ||
-				 CommandType == TEXT("set_component_property") ||
-				 CommandType == TEXT("set_physics_properties") ||
-				 CommandType == TEXT("compile_blueprint") ||
-				 CommandType == TEXT("set_mesh_material_color") ||
-				 CommandType == TEXT("connect_blueprint_nodes") ||
-				 CommandType == TEXT("add_component_getter_node") ||
-				 CommandType == TEXT("add_blueprint_event_node") ||
-				 CommandType == TEXT("add_custom_event_node") ||
-				 CommandType == TEXT("add_blueprint_function_node") ||
-				 CommandType == TEXT("add_blueprint_variable") ||
-				 CommandType == TEXT("add_blueprint_input_action_node") ||
-				 CommandType == TEXT("add_blueprint_self_reference") ||
-				 CommandType == TEXT("list_blueprint_nodes") ||
-				 CommandType == TEXT("apply_material_to_blueprint") ||
-				 CommandType == TEXT("get_blueprint_material_info") ||
-				 CommandType == TEXT("add_comment_box") ||
-				 CommandType == TEXT("analyze_blueprint") ||
-				 CommandType == TEXT("add_blueprint_flow_control_node") ||
-				 CommandType == TEXT("set_pin_default_value") ||
-				 CommandType == TEXT("add_blueprint_variable_node") ||
-				 CommandType == TEXT("create_gameplay_effect") ||
-				 CommandType == TEXT("create_gameplay_ability") ||
-				 CommandType == TEXT("list_attribute_sets") ||
-				 CommandType == TEXT("get_attribute_set_info") ||
-				 CommandType == TEXT("search_functions") ||
-				 CommandType == TEXT("get_class_functions") ||
-				 CommandType == TEXT("add_function_override") ||
-				 CommandType == TEXT("add_ability_task_node") ||
-				 CommandType == TEXT("add_blueprint_generic_node") ||
-				 CommandType == TEXT("set_node_property") ||
-				 CommandType == TEXT("connect_nodes") ||
-				 CommandType == TEXT("list_graphs") ||
-				 CommandType == TEXT("create_child_blueprint") ||
-				 CommandType == TEXT("build_ability_graph") ||
-				 CommandType == TEXT("delete_blueprint_node") ||
-				 CommandType == TEXT("delete_blueprint_variable") ||
-				 CommandType == TEXT("delete_component_from_blueprint") ||
-				 CommandType == TEXT("disconnect_blueprint_nodes") ||
-				 CommandType == TEXT("add_pin") ||
-				 CommandType == TEXT("delete_pin") ||
-				 CommandType == TEXT("get_class_properties") ||
-				 CommandType == TEXT("get_blueprint_variables") ||
-				 CommandType == TEXT("add_property_get_set_node") ||
-				 CommandType == TEXT("get_pin_value"))
-		{
-			ResultJson = BlueprintCommandHandler->HandleCommand(CommandType, Params);
-		}
-		// PCG commands
-		else if (CommandType == TEXT("create_pcg_graph") ||
-				 CommandType == TEXT("analyze_pcg_graph") ||
-				 CommandType == TEXT("set_pcg_graph_to_component") ||
-				 CommandType == TEXT("add_pcg_sampler_node") ||
-				 CommandType == TEXT("add_pcg_filter_node") ||
-				 CommandType == TEXT("add_pcg_transform_node") ||
-				 CommandType == TEXT("add_pcg_spawner_node") ||
-				 CommandType == TEXT("add_pcg_attribute_node") ||
-				 CommandType == TEXT("add_pcg_flow_control_node") ||
-				 CommandType == TEXT("add_pcg_generic_node") ||
-				 CommandType == TEXT("list_pcg_nodes") ||
-				 CommandType == TEXT("connect_pcg_nodes") ||
-				 CommandType == TEXT("disconnect_pcg_nodes") ||
-				 CommandType == TEXT("delete_pcg_node"))
-		{
-			ResultJson = PCGCommandHandler->HandleCommand(CommandType, Params);
+bool UUnrealEngineMCPBridge::DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& ResponseWriter, TSharedPtr<FJsonObject>& OutResult)
+{
+	const FMcpCommandInfo* Command = Commands.Find(CommandType);
+	if (!Command)
+	{
+		return false;
+	}
+
+	bool bAsync = false;
+	if (Command->bSupportsJobs && Params->TryGetBoolField(TEXT("async"), bAsync) && bAsync)
+	{
+		OutResult = SubmitJob(CommandType, Params);
+		return true;
+	}
+
+	// Streaming handlers write the envelope themselves
+	if (Command->IsStreaming())
+	{
+		Command->StreamingHandler.Execute(Params, ResponseWriter);
+	}
+	else
+	{
+		OutResult = Command->Handler.Execute(Params);
+	}
+	return true;
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::HandlePing(const TSharedPtr<FJsonObject>& Params)
+{
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetStringField(TEXT("message"), TEXT("pong"));
+	ResultObj->SetBoolField(TEXT("success"), true);
+	return ResultObj;
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::HandleListConnections(const TSharedPtr<FJsonObject>& Params)
+{
+	if (!ConnectionManager.IsValid())
+	{
+		return FCommonUtils::CreateErrorResponse(TEXT("Server is not running"));
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = ConnectionManager->GetStatsJson();
+	ResultObj->SetObjectField(TEXT("responses"), GetResponseStatsJson());
+	ResultObj->SetObjectField(TEXT("response_cache"), ResponseCache.GetStatsJson());
+	ResultObj->SetNumberField(TEXT("event_subscribers"), Events->NumSubscribers());
+	return ResultObj;
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::HandleListCommands(const TSharedPtr<FJsonObject>& Params)
+{
+	return Commands.ToJson();
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::HandleJobStatus(const TSharedPtr<FJsonObject>& Params)
+{
+	FString JobId;
+	if (!Params->TryGetStringField(TEXT("job_id"), JobId))
+	{
+		return FCommonUtils::CreateErrorResponse(TEXT("Missing 'job_id' parameter"));
+	}
+
+	TSharedPtr<FJsonObject> StatusObj = Jobs.GetStatus(JobId);
+	return StatusObj.IsValid()
+		? StatusObj
+		: FCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown or expired job: %s"), *JobId));
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::HandleCancelJob(const TSharedPtr<FJsonObject>& Params)
+{
+	FString JobId;
+	if (!Params->TryGetStringField(TEXT("job_id"), JobId))
+	{
+		return FCommonUtils::CreateErrorResponse(TEXT("Missing 'job_id' parameter"));
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetBoolField(TEXT("cancelled"), Jobs.Cancel(JobId));
+	ResultObj->SetBoolField(TEXT("success"), true);
+	return ResultObj;
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::HandleListJobs(const TSharedPtr<FJsonObject>& Params)
+{
+	return Jobs.ListJobs();
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::HandleGetServerStats(const TSharedPtr<FJsonObject>& Params)
+{
+	FString CommandFilter;
+	Params->TryGetStringField(TEXT("command"), CommandFilter);
+
+	TSharedPtr<FJsonObject> ResultObj = ServerStats.ToJson(CommandFilter);
+
+	// Gauges are read live rather than accumulated
+	const TSharedPtr<FJsonObject>* QueueObj = nullptr;
+	if (ResultObj->TryGetObjectField(TEXT("queue"), QueueObj))
+	{
+		(*QueueObj)->SetNumberField(TEXT("pending"), PendingCommandCount.Load());
+		(*QueueObj)->SetNumberField(TEXT("workers_active"), ActiveWorkerCommands.Load());
+	}
+
+	// The snapshot above still covers the window that ends here
+	bool bReset = false;
+	if (Params->TryGetBoolField(TEXT("reset"), bReset) && bReset)
+	{
+		ServerStats.Reset();
+	}
+	ResultObj->SetBoolField(TEXT("reset"), bReset);
+	ResultObj->SetBoolField(TEXT("success"), true);
+	return ResultObj;
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::MakeEnvelope(const TSharedPtr<FJsonObject>& ResultJson)
+{
+	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+
+	bool bSuccess = true;
+	FString ErrorMessage;
+
+	if (ResultJson->HasField(TEXT("success")))
+	{
+		bSuccess = ResultJson->GetBoolField(TEXT("success"));
+		if (!bSuccess && ResultJson->HasField(TEXT("error")))
+		{
+			ErrorMessage = ResultJson->GetStringField(TEXT("error"));
 		}
-		else
+	}
+
+	if (bSuccess)
+	{
+		ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+		ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+	}
+	else
+	{
+		ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+		ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+	}
+
+	return ResponseJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::MakeErrorEnvelope(const FString& Message)
+{
+	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+	ResponseJson->SetStringField(TEXT("error"), Message);
+	return ResponseJson;
+}
+
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::SubmitJob(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+	// The job runs the plain command, so it must not see "async" again
+	TSharedPtr<FJsonObject> JobParams = MakeShared<FJsonObject>(*Params);
+	JobParams->RemoveField(TEXT("async"));
+
+	FMcpJobSliceFunction Work;
+	if (CommandType == TEXT("set_region_loaded"))
+	{
+		Work = EditorCommandHandler->MakeSetRegionLoadedJob(JobParams);
+	}
+	else
+	{
+		// The engine call behind these cannot be split, so the whole command is one slice
+		Work = [this, CommandType, JobParams](float& OutProgress) -> TSharedPtr<FJsonObject>
+		{
+			FMcpResponseWriter UnusedWriter;
+			TSharedPtr<FJsonObject> ResultJson;
+			try
+			{
+				DispatchCommand(CommandType, JobParams, UnusedWriter, ResultJson);
+			}
+			catch (const std::exception& e)
+			{
+				return FCommonUtils::CreateErrorResponse(UTF8_TO_TCHAR(e.what()));
+			}
+
+			OutProgress = 1.0f;
+			return ResultJson.IsValid() ? ResultJson : FCommonUtils::CreateErrorResponse(TEXT("Command produced no result"));
+		};
+	}
+
+	// Slices change the editor long after the submitting request was answered
+	Work = [this, CommandType, JobParams, Slice = MoveTemp(Work)](float& OutProgress) -> TSharedPtr<FJsonObject>
+	{
+		TSharedPtr<FJsonObject> ResultJson = Slice(OutProgress);
+		ResponseCache.NoteCommandExecuted(CommandType, JobParams);
+		return ResultJson;
+	};
+
+	FString SubmitError;
+	const FString JobId = Jobs.Submit(CommandType, MoveTemp(Work), SubmitError);
+	if (JobId.IsEmpty())
+	{
+		return FCommonUtils::CreateErrorResponse(SubmitError);
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetStringField(TEXT("job_id"), JobId);
+	ResultObj->SetStringField(TEXT("type"), CommandType);
+	ResultObj->SetStringField(TEXT("state"), McpJobs::ToString(EMcpJobState::Queued));
+	ResultObj->SetBoolField(TEXT("success"), true);
+	return ResultObj;
+}
+
+void UUnrealEngineMCPBridge::HandleBatch(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& ResponseWriter)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+	if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("commands"), Commands))
+	{
+		ResponseWriter.WriteError(TEXT("Missing 'commands' array"));
+		return;
+	}
+
+	if (Commands->Num() > MCP_MAX_BATCH_COMMANDS)
+	{
+		ResponseWriter.WriteError(FString::Printf(TEXT("Batch has %d commands, limit is %d"), Commands->Num(), MCP_MAX_BATCH_COMMANDS));
+		return;
+	}
+
+	bool bStopOnError = false;
+	Params->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+
+	// All-or-nothing: the first failure stops the batch and undoes the steps before it
+	bool bTransactional = false;
+	Params->TryGetBoolField(TEXT("transaction"), bTransactional);
+
+	TUniquePtr<FMcpBatchTransaction> Transaction;
+	if (bTransactional)
+	{
+		Transaction = MakeUnique<FMcpBatchTransaction>(TEXT("MCP Batch"));
+		if (!Transaction->IsOpen())
 		{
-			ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-			ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+			ResponseWriter.WriteError(TEXT("Transactions are not available"));
+			return;
+		}
+		bStopOnError = true;
+	}
+
+	const double BatchStartTime = FPlatformTime::Seconds();
+	int32 Succeeded = 0;
+	int32 Failed = 0;
+	int32 Skipped = 0;
+	bool bCancelled = false;
 
-			FString ResultString;
-			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
-				TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ResultString);
-			FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-			return ResultString;
+	// Result object of every step so far (null unless it succeeded), for $stepN references
+	TArray<TSharedPtr<FJsonObject>> StepResults;
+	StepResults.Reserve(Commands->Num());
+
+	ResponseWriter.BeginSuccess();
+	FMcpItemWriter Results(ResponseWriter, TEXT("results"));
+
+	for (int32 Index = 0; Index < Commands->Num(); Index++)
+	{
+		const TSharedPtr<FJsonObject>* Command = nullptr;
+		FString StepType;
+		if ((*Commands)[Index].IsValid())
+		{
+			(*Commands)[Index]->TryGetObject(Command);
+		}
+		if (Command)
+		{
+			(*Command)->TryGetStringField(TEXT("type"), StepType);
 		}
 
-		bool bSuccess = true;
-		FString ErrorMessage;
+		TSharedPtr<FJsonObject> Step = MakeShared<FJsonObject>();
+		Step->SetNumberField(TEXT("index"), Index);
+		Step->SetStringField(TEXT("type"), StepType);
 
-		if (ResultJson->HasField(TEXT("success")))
+		// Once a step failed with stop_on_error, or the batch was cancelled, the rest are reported but not run
+		bCancelled = bCancelled || ResponseWriter.IsCancelled();
+		if (bCancelled || (bStopOnError && Failed > 0))
 		{
-			bSuccess = ResultJson->GetBoolField(TEXT("success"));
-			if (!bSuccess && ResultJson->HasField(TEXT("error")))
+			Step->SetStringField(TEXT("status"), TEXT("skipped"));
+			Results.AddItem(Step);
+			StepResults.Add(nullptr);
+			Skipped++;
+			continue;
+		}
+
+		const double StepStartTime = FPlatformTime::Seconds();
+		TSharedPtr<FJsonObject> Envelope;
+		if (!Command || StepType.IsEmpty())
+		{
+			Envelope = MakeErrorEnvelope(TEXT("Each batch entry needs a 'type'"));
+		}
+		else if (StepType == TEXT("batch"))
+		{
+			Envelope = MakeErrorEnvelope(TEXT("Nested batch is not supported"));
+		}
+		else
+		{
+			const TSharedPtr<FJsonObject>* StepParams = nullptr;
+			(*Command)->TryGetObjectField(TEXT("params"), StepParams);
+
+			TSharedPtr<FJsonObject> ResolvedParams;
+			FString ReferenceError;
+			if (!McpBatch::ResolveReferences(StepParams ? *StepParams : MakeShared<FJsonObject>(), StepResults, ResolvedParams, ReferenceError))
 			{
-				ErrorMessage = ResultJson->GetStringField(TEXT("error"));
+				Envelope = MakeErrorEnvelope(ReferenceError);
 			}
+			else
+			{
+				if (Transaction.IsValid())
+				{
+					Transaction->CaptureTargets(ResolvedParams);
+				}
+				Envelope = ExecuteBatchStep(StepType, ResolvedParams);
+			}
+		}
+
+		// Step carries the sub-command's own envelope fields alongside its index and timing
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Envelope->Values)
+		{
+			Step->SetField(Field.Key, Field.Value);
 		}
+		Step->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StepStartTime) * 1000.0);
 
-		if (bSuccess)
+		if (Envelope->GetStringField(TEXT("status")) == TEXT("success"))
 		{
-			ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-			ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+			const TSharedPtr<FJsonObject>* StepResult = nullptr;
+			Envelope->TryGetObjectField(TEXT("result"), StepResult);
+			StepResults.Add(StepResult ? *StepResult : nullptr);
+			Succeeded++;
 		}
 		else
 		{
-			ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-			ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+			StepResults.Add(nullptr);
+			Failed++;
 		}
+
+		Results.AddItem(Step);
 	}
-	catch (const std::exception& e)
+
+	Results.Finish();
+
+	FMcpValueWriter& Values = ResponseWriter.Values();
+
+	if (Transaction.IsValid())
 	{
-		ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-		ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+		Values.WriteObjectStart(TEXT("transaction"));
+		if (Failed > 0 || bCancelled)
+		{
+			Transaction->Rollback();
+			Values.WriteValue(TEXT("committed"), false);
+			Values.WriteValue(TEXT("rolled_back"), true);
+		}
+		else
+		{
+			const TArray<FString> Compiled = Transaction->Commit();
+			Values.WriteValue(TEXT("committed"), true);
+			Values.WriteValue(TEXT("rolled_back"), false);
+			Values.WriteArrayStart(TEXT("compiled"));
+			for (const FString& BlueprintName : Compiled)
+			{
+				Values.WriteValue(BlueprintName);
+			}
+			Values.WriteArrayEnd();
+		}
+		Values.WriteObjectEnd();
 	}
 
-	FString ResultString;
-	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
-		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ResultString);
-	FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-	return ResultString;
+	Values.WriteValue(TEXT("count"), Commands->Num());
+	Values.WriteValue(TEXT("succeeded"), Succeeded);
+	Values.WriteValue(TEXT("failed"), Failed);
+	Values.WriteValue(TEXT("skipped"), Skipped);
+	Values.WriteValue(TEXT("cancelled"), bCancelled);
+	Values.WriteValue(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - BatchStartTime) * 1000.0);
+	ResponseWriter.EndSuccess();
 }
 
-void UUnrealEngineMCPBridge::StartServer()
+TSharedPtr<FJsonObject> UUnrealEngineMCPBridge::ExecuteBatchStep(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
-	if (bIsRunning)
+	UE_LOG(LogTemp, Verbose, TEXT("UnrealEngineMCPBridge: Batch step: %s"), *CommandType);
+
+	// Streaming handlers serialize their envelope, so give them a JSON writer and read it back
+	FMcpResponseWriter StepWriter;
+	TSharedPtr<FJsonObject> ResultJson;
+
+	try
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UnrealEngineMCPBridge: Server is already running"));
-		return;
+		if (!DispatchCommand(CommandType, Params, StepWriter, ResultJson))
+		{
+			return MakeErrorEnvelope(FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+		}
+	}
+	catch (const std::exception& e)
+	{
+		return MakeErrorEnvelope(UTF8_TO_TCHAR(e.what()));
 	}
 
-	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-	if (!SocketSubsystem)
+	if (ResultJson.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEngineMCPBridge: Failed to get socket subsystem"));
-		return;
+		return MakeEnvelope(ResultJson);
 	}
 
-	TSharedPtr<FSocket> NewListenerSocket = TSharedPtr<FSocket>(
-		SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealEngineMCPListener"), false)
-	);
+	TArray<uint8> Serialized;
+	Serialized.Reserve(StepWriter.BodySize());
+	for (const TArray<uint8>& Chunk : StepWriter.MoveBody().GetChunks())
+	{
+		Serialized.Append(Chunk);
+	}
 
-	if (!NewListenerSocket.IsValid())
+	TSharedPtr<FJsonObject> Envelope;
+	TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(
+		FUtf8StringView((const UTF8CHAR*)Serialized.GetData(), Serialized.Num()));
+	if (!FJsonSerializer::Deserialize(Reader, Envelope) || !Envelope.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEngineMCPBridge: Failed to create listener socket"));
-		return;
+		return MakeErrorEnvelope(TEXT("Failed to read step result"));
 	}
+	return Envelope;
+}
 
-	NewListenerSocket->SetReuseAddr(true);
-	NewListenerSocket->SetNonBlocking(true);
+void UUnrealEngineMCPBridge::StartServer()
+{
+	if (bIsRunning)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UnrealEngineMCPBridge: Server is already running"));
+		return;
+	}
 
-	FIPv4Endpoint Endpoint(ServerAddress, Port);
-	if (!NewListenerSocket->Bind(*Endpoint.ToInternetAddr()))
+	TSharedPtr<FMcpListener> TcpListener = McpTransport::CreateTcpListener(ServerAddress, Port, MaxConnections);
+	if (!TcpListener.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEngineMCPBridge: Failed to bind to %s:%d"),
+		UE_LOG(LogTemp, Error, TEXT("UnrealEngineMCPBridge: Failed to start listening on %s:%d"),
 			   *ServerAddress.ToString(), Port);
 		return;
 	}
+	Listeners.Add(TcpListener);
 
-	if (!NewListenerSocket->Listen(5))
+	// The local socket is an optional fast path; TCP alone is still a working server
+	if (!LocalSocketPath.IsEmpty())
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEngineMCPBridge: Failed to start listening"));
-		return;
+		TSharedPtr<FMcpListener> LocalListener = McpTransport::CreateLocalListener(LocalSocketPath, MaxConnections);
+		if (LocalListener.IsValid())
+		{
+			Listeners.Add(LocalListener);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UnrealEngineMCPBridge: Local socket unavailable, serving TCP only"));
+		}
 	}
 
-	ListenerSocket = NewListenerSocket;
-	bIsRunning = true;
+	ConnectionManager = MakeShared<FMcpConnectionManager>(this, MaxConnections);
 
-	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Server started on %s:%d"),
-		   *ServerAddress.ToString(), Port);
+	Events = MakeShared<FMcpEventHub>();
+	Events->Start();
+	ResponseCache.Start();
 
-	ServerThread = FRunnableThread::Create(
-		new FUnrealEngineMCPRunnable(this, ListenerSocket),
-		TEXT("UnrealEngineMCPServerThread"),
-		0,
-		TPri_Normal
-	);
+	bIsRunning = true;
 
-	if (!ServerThread)
+	for (const TSharedPtr<FMcpListener>& Listener : Listeners)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UnrealEngineMCPBridge: Failed to create server thread"));
-		StopServer();
-		return;
+		FRunnableThread* ServerThread = FRunnableThread::Create(
+			new FUnrealEngineMCPRunnable(this, Listener, ConnectionManager),
+			TEXT("UnrealEngineMCPServerThread"),
+			0,
+			TPri_Normal
+		);
+
+		if (!ServerThread)
+		{
+			UE_LOG(LogTemp, Error, TEXT("UnrealEngineMCPBridge: Failed to create server thread for %s"), *Listener->Describe());
+			StopServer();
+			return;
+		}
+		ServerThreads.Add(ServerThread);
+
+		UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Listening on %s"), *Listener->Describe());
 	}
+
+	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Server started (max %d connections)"), MaxConnections);
 }
 
 void UUnrealEngineMCPBridge::StopServer()
@@ -372,27 +1119,51 @@ void UUnrealEngineMCPBridge::StopServer()
 
 	bIsRunning = false;
 
-	if (ServerThread)
+	for (FRunnableThread* ServerThread : ServerThreads)
 	{
 		ServerThread->Kill(true);
 		delete ServerThread;
-		ServerThread = nullptr;
 	}
+	ServerThreads.Empty();
+
+	if (ConnectionManager.IsValid())
+	{
+		ConnectionManager->CloseAll();
+		ConnectionManager.Reset();
+	}
+
+	// Closes the listening sockets and removes the local socket file
+	Listeners.Empty();
 
-	if (ListenerSocket.IsValid())
+	// Workers finish on their own - they never wait for the game thread
+	while (ActiveWorkerCommands.Load() > 0)
 	{
-		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenerSocket.Get());
-		ListenerSocket.Reset();
+		FPlatformProcess::Sleep(0.001f);
 	}
 
 	// Clear queues
 	FMcpCommandRequest DummyRequest;
 	while (CommandQueue.Dequeue(DummyRequest)) {}
+	Scheduler.Reset();
+	{
+		FScopeLock Lock(&OutstandingRequestsLock);
+		OutstandingRequests.Reset();
+	}
+	Jobs.Reset();
+	IdempotentResults.Reset();
+	ResponseCache.Stop();
 
+	// Connections are gone, so nothing subscribes any more
+	if (Events.IsValid())
 	{
-		FScopeLock Lock(&ResponseMapLock);
-		ResponseMap.Empty();
+		Events->Stop();
+		Events.Reset();
 	}
 
+	// Slots themselves are owned by their requests and connections
+	FMcpResponseSlotWeakPtr DummySlot;
+	while (FulfilledSlots.Dequeue(DummySlot)) {}
+	UnclaimedSlots.Empty();
+
 	UE_LOG(LogTemp, Display, TEXT("UnrealEngineMCPBridge: Server stopped"));
 }
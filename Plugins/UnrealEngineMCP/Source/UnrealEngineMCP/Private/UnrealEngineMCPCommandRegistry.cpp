@@ -0,0 +1,106 @@
+#include "UnrealEngineMCPCommandRegistry.h"
+#include "Dom/JsonValue.h"
+
+namespace
+{
+	const TCHAR* ParamTypeToString(EMcpParamType Type)
+	{
+		switch (Type)
+		{
+		case EMcpParamType::String:
+			return TEXT("string");
+		case EMcpParamType::Number:
+			return TEXT("number");
+		case EMcpParamType::Boolean:
+			return TEXT("boolean");
+		case EMcpParamType::Array:
+			return TEXT("array");
+		case EMcpParamType::Object:
+			return TEXT("object");
+		case EMcpParamType::Any:
+		default:
+			return TEXT("any");
+		}
+	}
+}
+
+FMcpCommandInfo& FMcpCommandRegistry::Add(const TCHAR* CommandName, FMcpCommandDelegate Handler)
+{
+	FMcpCommandInfo& Info = AddInfo(CommandName);
+	Info.Handler = MoveTemp(Handler);
+	return Info;
+}
+
+FMcpCommandInfo& FMcpCommandRegistry::Add(const TCHAR* CommandName, FMcpStreamingCommandDelegate Handler)
+{
+	FMcpCommandInfo& Info = AddInfo(CommandName);
+	Info.StreamingHandler = MoveTemp(Handler);
+	return Info;
+}
+
+FMcpCommandInfo& FMcpCommandRegistry::AddInfo(const TCHAR* CommandName)
+{
+	const FName Name(CommandName);
+	if (Commands.Contains(Name))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FMcpCommandRegistry: Command %s registered twice, keeping the last one"), CommandName);
+	}
+
+	TUniquePtr<FMcpCommandInfo>& Info = Commands.Add(Name, MakeUnique<FMcpCommandInfo>());
+	Info->Name = Name;
+	return *Info;
+}
+
+const FMcpCommandInfo* FMcpCommandRegistry::Find(const FString& CommandType) const
+{
+	const FName Name(*CommandType, FNAME_Find);
+	if (Name.IsNone())
+	{
+		return nullptr;
+	}
+
+	const TUniquePtr<FMcpCommandInfo>* Info = Commands.Find(Name);
+	return Info ? Info->Get() : nullptr;
+}
+
+TSharedPtr<FJsonObject> FMcpCommandRegistry::ToJson() const
+{
+	TArray<const FMcpCommandInfo*> Sorted;
+	Sorted.Reserve(Commands.Num());
+	for (const TPair<FName, TUniquePtr<FMcpCommandInfo>>& Pair : Commands)
+	{
+		Sorted.Add(Pair.Value.Get());
+	}
+	Sorted.Sort([](const FMcpCommandInfo& A, const FMcpCommandInfo& B) { return A.Name.LexicalLess(B.Name); });
+
+	TArray<TSharedPtr<FJsonValue>> CommandsArray;
+	for (const FMcpCommandInfo* Info : Sorted)
+	{
+		TSharedPtr<FJsonObject> CommandObj = MakeShared<FJsonObject>();
+		CommandObj->SetStringField(TEXT("name"), Info->Name.ToString());
+		CommandObj->SetStringField(TEXT("cost_class"), McpScheduling::ToString(Info->CostClass));
+		CommandObj->SetStringField(TEXT("thread"), Info->Affinity == EMcpThreadAffinity::AnyThread ? TEXT("any") : TEXT("game"));
+		CommandObj->SetBoolField(TEXT("read_only"), Info->bReadOnly);
+		CommandObj->SetBoolField(TEXT("async"), Info->bSupportsJobs);
+		CommandObj->SetBoolField(TEXT("streaming"), Info->IsStreaming());
+
+		TArray<TSharedPtr<FJsonValue>> ParamsArray;
+		for (const FMcpParamSpec& Param : Info->Params)
+		{
+			TSharedPtr<FJsonObject> ParamObj = MakeShared<FJsonObject>();
+			ParamObj->SetStringField(TEXT("name"), Param.Name);
+			ParamObj->SetStringField(TEXT("type"), ParamTypeToString(Param.Type));
+			ParamObj->SetBoolField(TEXT("required"), Param.bRequired);
+			ParamsArray.Add(MakeShared<FJsonValueObject>(ParamObj));
+		}
+		CommandObj->SetArrayField(TEXT("params"), ParamsArray);
+
+		CommandsArray.Add(MakeShared<FJsonValueObject>(CommandObj));
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetArrayField(TEXT("commands"), CommandsArray);
+	ResultObj->SetNumberField(TEXT("count"), CommandsArray.Num());
+	ResultObj->SetBoolField(TEXT("success"), true);
+	return ResultObj;
+}
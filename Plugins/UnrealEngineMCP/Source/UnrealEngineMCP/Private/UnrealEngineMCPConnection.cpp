@@ -0,0 +1,997 @@
+#include "UnrealEngineMCPConnection.h"
+#include "UnrealEngineMCPBridge.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Event.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+
+#define MCP_RESPONSE_TIMEOUT 60.0f
+#define MCP_RECV_BUFFER_SIZE 65536
+#define MCP_MAX_MESSAGE_SIZE (64 * 1024 * 1024)
+#define MCP_SEND_WAIT_TIMEOUT 5.0f
+// Upper bound on how long a blocked wait goes without re-checking for shutdown/timeouts
+#define MCP_IDLE_WAIT_MS 250
+// Responses smaller than this are never compressed (clients may ask for a higher threshold)
+#define MCP_MIN_COMPRESSION_THRESHOLD 1024
+#define MCP_DEFAULT_COMPRESSION_THRESHOLD (16 * 1024)
+
+namespace
+{
+	// Serialize the envelope "id" so it can be echoed back verbatim. Only strings and numbers are accepted.
+	bool SerializeClientId(const TSharedPtr<FJsonValue>& IdValue, FString& OutClientId)
+	{
+		if (!IdValue.IsValid())
+		{
+			return false;
+		}
+
+		if (IdValue->Type == EJson::String)
+		{
+			OutClientId = FString::Printf(TEXT("\"%s\""), *IdValue->AsString().ReplaceCharWithEscapedChar());
+			return true;
+		}
+
+		if (IdValue->Type == EJson::Number)
+		{
+			const double Number = IdValue->AsNumber();
+			if (!FMath::IsFinite(Number))
+			{
+				return false;
+			}
+
+			// Integral ids print as integers only inside [-2^63, 2^63), where the cast is exact;
+			// larger ones keep their floating-point form
+			const bool bFitsInt64 = Number >= -9223372036854775808.0 && Number < 9223372036854775808.0;
+			OutClientId = (Number == FMath::FloorToDouble(Number) && bFitsInt64)
+				? FString::Printf(TEXT("%lld"), (int64)Number)
+				: FString::SanitizeFloat(Number);
+			return true;
+		}
+
+		return false;
+	}
+}
+
+TSharedPtr<FJsonObject> FMcpConnectionStats::ToJson() const
+{
+	TSharedPtr<FJsonObject> StatsObj = MakeShared<FJsonObject>();
+	StatsObj->SetNumberField(TEXT("connection_id"), ConnectionId);
+	StatsObj->SetStringField(TEXT("remote_address"), RemoteAddress);
+	StatsObj->SetStringField(TEXT("transport"), Transport);
+	StatsObj->SetNumberField(TEXT("connected_seconds"), FPlatformTime::Seconds() - ConnectedAt);
+	StatsObj->SetNumberField(TEXT("bytes_received"), BytesReceived);
+	StatsObj->SetNumberField(TEXT("bytes_sent"), BytesSent);
+	StatsObj->SetNumberField(TEXT("commands_received"), CommandsReceived);
+	StatsObj->SetNumberField(TEXT("commands_completed"), CommandsCompleted);
+	StatsObj->SetNumberField(TEXT("commands_rejected"), CommandsRejected);
+	StatsObj->SetNumberField(TEXT("in_flight"), InFlight);
+	StatsObj->SetStringField(TEXT("framing"), Framing);
+	StatsObj->SetStringField(TEXT("encoding"), Encoding);
+	StatsObj->SetStringField(TEXT("compression"), Compression);
+	StatsObj->SetNumberField(TEXT("compressed_responses"), CompressedResponses);
+	StatsObj->SetNumberField(TEXT("compression_saved_bytes"), CompressionSavedBytes);
+	return StatsObj;
+}
+
+FMcpClientConnection::FMcpClientConnection(
+	UUnrealEngineMCPBridge* InBridge,
+	uint32 InConnectionId,
+	TSharedPtr<FMcpStreamSocket> InSocket)
+	: Bridge(InBridge)
+	, ConnectionId(InConnectionId)
+	, Socket(InSocket)
+	, RemoteAddress(InSocket->GetRemoteAddress())
+	, Thread(nullptr)
+	, bRunning(true)
+	, bFinished(false)
+	, CompletionSignal(MakeShared<FMcpCompletionSignal, ESPMode::ThreadSafe>())
+	, CapacityEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, bAwaitingUntaggedResponse(false)
+	, ReceiveBuffer(MCP_RECV_BUFFER_SIZE)
+	, Framing(EMcpFraming::Newline)
+	, Encoding(EMcpEncoding::Json)
+	, Compression(EMcpCompression::None)
+	, CompressionThreshold(MCP_DEFAULT_COMPRESSION_THRESHOLD)
+	, ConnectedAt(FPlatformTime::Seconds())
+	, BytesReceived(0)
+	, BytesSent(0)
+	, CommandsReceived(0)
+	, CommandsCompleted(0)
+	, CommandsRejected(0)
+	, InFlightCount(0)
+	, CompressedResponses(0)
+	, CompressionSavedBytes(0)
+{
+}
+
+FMcpClientConnection::~FMcpClientConnection()
+{
+	Shutdown();
+
+	FPlatformProcess::ReturnSynchEventToPool(CapacityEvent);
+	CapacityEvent = nullptr;
+}
+
+bool FMcpClientConnection::Start()
+{
+	Thread = FRunnableThread::Create(
+		this,
+		*FString::Printf(TEXT("UnrealEngineMCPConnection_%u"), ConnectionId),
+		0,
+		TPri_Normal
+	);
+
+	if (!Thread)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FMcpClientConnection: Failed to create thread for connection %u"), ConnectionId);
+		bFinished = true;
+		return false;
+	}
+
+	return true;
+}
+
+void FMcpClientConnection::Shutdown()
+{
+	Stop();
+
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (Socket.IsValid())
+	{
+		Socket->Close();
+		Socket.Reset();
+	}
+}
+
+FMcpConnectionStats FMcpClientConnection::GetStats() const
+{
+	FMcpConnectionStats Stats;
+	Stats.ConnectionId = ConnectionId;
+	Stats.RemoteAddress = RemoteAddress;
+	Stats.Transport = Socket->GetTransportName();
+	Stats.ConnectedAt = ConnectedAt;
+	Stats.BytesReceived = BytesReceived.Load();
+	Stats.BytesSent = BytesSent.Load();
+	Stats.CommandsReceived = CommandsReceived.Load();
+	Stats.CommandsCompleted = CommandsCompleted.Load();
+	Stats.CommandsRejected = CommandsRejected.Load();
+	Stats.InFlight = InFlightCount.Load();
+	Stats.CompressedResponses = CompressedResponses.Load();
+	Stats.CompressionSavedBytes = CompressionSavedBytes.Load();
+	// Unlocked read - SendLock can be held for seconds by a stalled send, and a stale value is fine here
+	Stats.Framing = McpFraming::ToString(Framing);
+	Stats.Encoding = McpEncoding::ToString(Encoding);
+	Stats.Compression = McpFraming::ToString(Compression);
+	return Stats;
+}
+
+uint32 FMcpClientConnection::Run()
+{
+	UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: Handling connection %u from %s"), ConnectionId, *RemoteAddress);
+
+	WriterFuture = Async(EAsyncExecution::Thread, [this]() { RunWriter(); });
+
+	const FTimespan IdleWait = FTimespan::FromMilliseconds(MCP_IDLE_WAIT_MS);
+
+	while (bRunning && Socket.IsValid())
+	{
+		// Pipeline full or legacy request outstanding: leave data in the kernel buffer until the writer frees capacity
+		if (!HasCapacity())
+		{
+			CapacityEvent->Wait(MCP_IDLE_WAIT_MS);
+			if (!ProcessReceiveBuffer())
+			{
+				break;
+			}
+			continue;
+		}
+
+		if (!Socket->Wait(ESocketWaitConditions::WaitForRead, IdleWait))
+		{
+			continue;
+		}
+
+		// Receive straight into the buffer tail - bytes stay UTF-8 until a whole frame is available
+		int32 FreeBytes = 0;
+		uint8* WritePtr = ReceiveBuffer.PrepareWrite(MCP_RECV_BUFFER_SIZE, FreeBytes);
+
+		int32 BytesRead = 0;
+		if (Socket->Recv(WritePtr, FreeBytes, BytesRead))
+		{
+			if (BytesRead == 0)
+			{
+				UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: Client %u disconnected (zero bytes)"), ConnectionId);
+				break;
+			}
+
+			BytesReceived += BytesRead;
+			Bridge->GetServerStats().AddBytesReceived(BytesRead);
+			ReceiveBuffer.CommitWrite(BytesRead);
+
+			if (!ProcessReceiveBuffer())
+			{
+				break;
+			}
+		}
+		else
+		{
+			int32 LastError = (int32)Socket->GetLastError();
+
+			if (LastError == SE_EWOULDBLOCK || LastError == SE_EINTR)
+			{
+				continue;
+			}
+			else if (LastError == SE_NO_ERROR)
+			{
+				break;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: Socket error on connection %u: %d"), ConnectionId, LastError);
+				break;
+			}
+		}
+	}
+
+	// Wake and join the writer
+	bRunning = false;
+	CompletionSignal->Trigger();
+	if (WriterFuture.IsValid())
+	{
+		WriterFuture.Wait();
+	}
+
+	int32 Abandoned = 0;
+	{
+		FScopeLock Lock(&InFlightLock);
+		Abandoned = InFlightRequests.Num();
+
+		// Nobody will read the rest - queued commands are skipped and running handlers can stop early
+		for (const TPair<uint32, FMcpInFlightRequest>& Pair : InFlightRequests)
+		{
+			Pair.Value.Cancellation->Abandon();
+		}
+		InFlightRequests.Empty();
+
+		for (const TPair<FString, FMcpResponseStreamPtr>& Pair : Subscriptions)
+		{
+			Bridge->Unsubscribe(Pair.Value);
+		}
+		Subscriptions.Empty();
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: Connection %u closed (in: %lld bytes, out: %lld bytes, commands: %d, abandoned: %d)"),
+		ConnectionId, BytesReceived.Load(), BytesSent.Load(), CommandsCompleted.Load(), Abandoned);
+	return 0;
+}
+
+void FMcpClientConnection::Stop()
+{
+	bRunning = false;
+	CompletionSignal->Trigger();
+	CapacityEvent->Trigger();
+}
+
+void FMcpClientConnection::Exit()
+{
+	bFinished = true;
+}
+
+void FMcpClientConnection::RunWriter()
+{
+	while (bRunning)
+	{
+		// Woken by the bridge as soon as a response is stored; the timeout only drives the request timeout sweep
+		CompletionSignal->Wait(MCP_IDLE_WAIT_MS);
+
+		bool bDelivered = false;
+		if (!DeliverCompletedResponses(bDelivered))
+		{
+			// Fatal for the connection - the reader notices on its next wake
+			bRunning = false;
+			CapacityEvent->Trigger();
+			break;
+		}
+
+		if (bDelivered)
+		{
+			CapacityEvent->Trigger();
+		}
+	}
+}
+
+bool FMcpClientConnection::HasCapacity() const
+{
+	FScopeLock Lock(&InFlightLock);
+	return !bAwaitingUntaggedResponse && InFlightRequests.Num() < MCP_MAX_INFLIGHT_PER_CONNECTION;
+}
+
+bool FMcpClientConnection::SendBytes(const uint8* Data, int32 Count)
+{
+	if (!Socket.IsValid())
+	{
+		return false;
+	}
+
+	// Socket is non-blocking - large responses may need several sends
+	int32 Remaining = Count;
+	while (Remaining > 0)
+	{
+		int32 SentCount = 0;
+		if (Socket->Send(Data, Remaining, SentCount))
+		{
+			Data += SentCount;
+			Remaining -= SentCount;
+			BytesSent += SentCount;
+			Bridge->GetServerStats().AddBytesSent(SentCount);
+			continue;
+		}
+
+		int32 LastError = (int32)Socket->GetLastError();
+		if (LastError != SE_EWOULDBLOCK && LastError != SE_EINTR)
+		{
+			return false;
+		}
+
+		if (!Socket->Wait(ESocketWaitConditions::WaitForWrite, FTimespan::FromSeconds(MCP_SEND_WAIT_TIMEOUT)))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: [%u] Send stalled, client not reading"), ConnectionId);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FMcpResponseBody FMcpClientConnection::EncodeResponse(const FString& Response) const
+{
+	// Unlocked read - only the reader thread changes Encoding, and never while requests are in flight
+	if (Encoding == EMcpEncoding::Json)
+	{
+		return FMcpResponseBody::FromString(Response);
+	}
+
+	TSharedPtr<FJsonObject> ResponseJson;
+	FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Response), ResponseJson);
+
+	FMcpResponseWriter Writer(nullptr, Encoding);
+	Writer.WriteResponse(ResponseJson.IsValid() ? ResponseJson : MakeShared<FJsonObject>());
+	return Writer.MoveBody();
+}
+
+bool FMcpClientConnection::SendResponse(const FString& ClientId, const FString& Response)
+{
+	return SendResponse(ClientId, EncodeResponse(Response));
+}
+
+bool FMcpClientConnection::SendResponse(const FString& ClientId, const FMcpResponseBody& Body)
+{
+	FScopeLock Lock(&SendLock);
+
+	// Body is always an object (JSON or CBOR map) - splice the id in as its first field
+	TArray<uint8> Staging;
+	int32 SkipBytes = 0;
+	int64 PayloadSize = Body.Num();
+	if (!ClientId.IsEmpty())
+	{
+		McpEncoding::AppendIdPrefix(Encoding, ClientId, Staging);
+		SkipBytes = 1;
+		PayloadSize += Staging.Num() - SkipBytes;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: [%u] Sending response (%lld bytes): %s"),
+		   ConnectionId, PayloadSize, Encoding == EMcpEncoding::Json ? *Body.Preview(200) : McpEncoding::ToString(Encoding));
+
+	if (Compression != EMcpCompression::None && Framing == EMcpFraming::LengthPrefixed && PayloadSize >= CompressionThreshold)
+	{
+		return SendCompressedResponse(Staging, Body, SkipBytes);
+	}
+
+	TArray<uint8> Header;
+	McpFraming::AppendHeader((uint32)PayloadSize, Framing, Header);
+	Staging.Insert(Header, 0);
+
+	// Small pieces are coalesced into one send; full chunks go out directly without another copy
+	for (int32 ChunkIndex = 0; ChunkIndex < Body.GetChunks().Num(); ++ChunkIndex)
+	{
+		const TArray<uint8>& Chunk = Body.GetChunks()[ChunkIndex];
+		const int32 Offset = (ChunkIndex == 0) ? SkipBytes : 0;
+		const int32 Count = Chunk.Num() - Offset;
+
+		if (Staging.Num() + Count > FMcpResponseBody::ChunkSize && Staging.Num() > 0)
+		{
+			if (!SendBytes(Staging.GetData(), Staging.Num()))
+			{
+				return false;
+			}
+			Staging.Reset();
+		}
+
+		if (Count >= FMcpResponseBody::ChunkSize)
+		{
+			if (!SendBytes(Chunk.GetData() + Offset, Count))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			Staging.Append(Chunk.GetData() + Offset, Count);
+		}
+	}
+
+	McpFraming::AppendTrailer(Framing, Staging);
+	return Staging.Num() == 0 || SendBytes(Staging.GetData(), Staging.Num());
+}
+
+bool FMcpClientConnection::SendCompressedResponse(const TArray<uint8>& IdPrefix, const FMcpResponseBody& Body, int32 SkipBytes)
+{
+	// Codecs need one contiguous input
+	TArray<uint8> Payload;
+	Payload.Reserve(IdPrefix.Num() + Body.Num());
+	Payload.Append(IdPrefix);
+	for (int32 ChunkIndex = 0; ChunkIndex < Body.GetChunks().Num(); ++ChunkIndex)
+	{
+		const TArray<uint8>& Chunk = Body.GetChunks()[ChunkIndex];
+		const int32 Offset = (ChunkIndex == 0) ? SkipBytes : 0;
+		Payload.Append(Chunk.GetData() + Offset, Chunk.Num() - Offset);
+	}
+
+	TArray<uint8> Frame;
+	if (McpFraming::AppendCompressedFrame(Payload.GetData(), Payload.Num(), Compression, Frame))
+	{
+		CompressedResponses++;
+		CompressionSavedBytes += Payload.Num() - Frame.Num();
+	}
+	else
+	{
+		// Incompressible - send as a plain frame
+		McpFraming::AppendHeader((uint32)Payload.Num(), Framing, Frame);
+		Frame.Append(Payload);
+	}
+
+	return SendBytes(Frame.GetData(), Frame.Num());
+}
+
+bool FMcpClientConnection::DeliverCompletedResponses(bool& bOutDelivered)
+{
+	bOutDelivered = false;
+	const double Now = FPlatformTime::Seconds();
+
+	struct FPendingFrame
+	{
+		FString ClientId;
+		FMcpResponseBody Body;
+		bool bFinal;
+		bool bCommandResponse = false;             // Frames of a command's own response go into its stats
+		const FMcpCommandInfo* Command = nullptr;
+		double StartTime = 0.0;                    // When the request was received (final frames)
+	};
+
+	// Collect under the lock, send outside it so the reader is never blocked on socket writes
+	TArray<FPendingFrame> ToSend;
+	TArray<FMcpResponseBody> Chunks;
+	bool bLegacyTimeout = false;
+
+	{
+		FScopeLock Lock(&InFlightLock);
+
+		for (auto It = InFlightRequests.CreateIterator(); It; ++It)
+		{
+			FMcpInFlightRequest& InFlight = It.Value();
+
+			// Final response first: chunks are pushed before it is stored, so none can be left behind
+			const bool bCompleted = InFlight.ResponseSlot->IsDone();
+
+			if (InFlight.Stream.IsValid() && InFlight.Stream->PopChunks(Chunks))
+			{
+				for (FMcpResponseBody& Chunk : Chunks)
+				{
+					ToSend.Add({ InFlight.ClientId, MoveTemp(Chunk), false, true, InFlight.Command });
+				}
+				Chunks.Reset();
+				InFlight.LastProgressTime = Now;
+			}
+
+			if (bCompleted)
+			{
+				if (InFlight.ClientId.IsEmpty())
+				{
+					bAwaitingUntaggedResponse = false;
+				}
+
+				FMcpResponseBody Body;
+				if (!InFlight.ResponseSlot->Take(Body))
+				{
+					// Only if this writer stalled past the response TTL
+					Body = EncodeResponse(TEXT("{\"status\":\"error\",\"error\":\"Response expired before it could be sent\"}"));
+				}
+				ToSend.Add({ InFlight.ClientId, MoveTemp(Body), true, true, InFlight.Command, InFlight.StartTime });
+				It.RemoveCurrent();
+			}
+			else if (InFlight.Cancellation->IsPastDeadline())
+			{
+				UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: [%u] Deadline exceeded for command: %s"), ConnectionId, *InFlight.CommandType);
+
+				if (InFlight.ClientId.IsEmpty())
+				{
+					bAwaitingUntaggedResponse = false;
+				}
+				ToSend.Add({ InFlight.ClientId, EncodeResponse(TEXT("{\"status\":\"error\",\"error\":\"Deadline exceeded\"}")), true });
+
+				InFlight.Cancellation->Abandon();
+				It.RemoveCurrent();
+			}
+			else if ((Now - InFlight.LastProgressTime) > MCP_RESPONSE_TIMEOUT)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: [%u] Response timeout for command: %s"), ConnectionId, *InFlight.CommandType);
+
+				if (InFlight.ClientId.IsEmpty())
+				{
+					bLegacyTimeout = true;
+				}
+				else
+				{
+					ToSend.Add({ InFlight.ClientId, EncodeResponse(TEXT("{\"status\":\"error\",\"error\":\"Command timeout\"}")), true });
+				}
+
+				// Otherwise the command would still run later and its response would never be collected
+				InFlight.Cancellation->Abandon();
+				It.RemoveCurrent();
+			}
+		}
+
+		InFlightCount = InFlightRequests.Num();
+
+		for (const TPair<FString, FMcpResponseStreamPtr>& Pair : Subscriptions)
+		{
+			if (Pair.Value->PopChunks(Chunks))
+			{
+				for (FMcpResponseBody& Chunk : Chunks)
+				{
+					ToSend.Add({ Pair.Key, MoveTemp(Chunk), false });
+				}
+				Chunks.Reset();
+			}
+		}
+	}
+
+	for (const FPendingFrame& Pending : ToSend)
+	{
+		const double SendStartTime = FPlatformTime::Seconds();
+		if (!SendResponse(Pending.ClientId, Pending.Body))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: [%u] Failed to send response"), ConnectionId);
+			return false;
+		}
+
+		if (Pending.bCommandResponse)
+		{
+			if (Pending.bFinal)
+			{
+				const double SentTime = FPlatformTime::Seconds();
+				Bridge->GetServerStats().RecordDelivery(Pending.Command, Pending.Body.Num(), SentTime - SendStartTime, SentTime - Pending.StartTime);
+			}
+			else
+			{
+				Bridge->GetServerStats().RecordResponseBytes(Pending.Command, Pending.Body.Num());
+			}
+		}
+
+		if (Pending.bFinal)
+		{
+			CommandsCompleted++;
+			bOutDelivered = true;
+		}
+	}
+
+	if (bLegacyTimeout)
+	{
+		// Legacy clients cannot match a late response - drop the connection as before
+		SendResponse(FString(), TEXT("{\"status\":\"error\",\"error\":\"Command timeout\"}"));
+		return false;
+	}
+
+	return true;
+}
+
+bool FMcpClientConnection::ProcessReceiveBuffer()
+{
+	while (HasCapacity())
+	{
+		TArrayView<const uint8> Frame;
+		int32 Consumed = 0;
+		const EMcpFrameResult Result = ReceiveBuffer.PeekFrame(Framing, MCP_MAX_MESSAGE_SIZE, Frame, Consumed);
+
+		if (Result == EMcpFrameResult::Incomplete)
+		{
+			return true;
+		}
+
+		if (Result == EMcpFrameResult::TooLarge)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: Client %u exceeded max message size (%d), dropping"),
+				ConnectionId, MCP_MAX_MESSAGE_SIZE);
+			SendResponse(FString(), TEXT("{\"status\":\"error\",\"error\":\"Message too large\"}"));
+			return false;
+		}
+
+		// Parsed in place - the view is only valid until the frame is consumed
+		bool bHandled = true;
+		if (Encoding == EMcpEncoding::Cbor)
+		{
+			bHandled = Frame.Num() == 0 || HandleBinaryMessage(Frame);
+		}
+		else
+		{
+			const FUtf8StringView CompleteMessage = FUtf8StringView((const UTF8CHAR*)Frame.GetData(), Frame.Num()).TrimStartAndEnd();
+			bHandled = CompleteMessage.IsEmpty() || HandleMessage(CompleteMessage);
+		}
+		ReceiveBuffer.Consume(Consumed);
+
+		if (!bHandled)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FMcpClientConnection::HandleMessage(FUtf8StringView Message)
+{
+	UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: [%u] Processing message: %s"),
+		   ConnectionId, *FString(Message.Left(200)));
+
+	// Read straight from the UTF-8 frame; only the strings that end up in the DOM are widened
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(Message);
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: [%u] Failed to parse JSON: %s"),
+			   ConnectionId, *FString(Message.Left(200)));
+		return false;
+	}
+
+	return DispatchMessage(JsonObject, Message.Len());
+}
+
+bool FMcpClientConnection::HandleBinaryMessage(TArrayView<const uint8> Message)
+{
+	UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: [%u] Processing CBOR message (%d bytes)"), ConnectionId, Message.Num());
+
+	// Decoded into the same DOM as a JSON request; numbers are read as binary values
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!McpEncoding::ReadCborObject(Message, JsonObject))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: [%u] Failed to parse CBOR message"), ConnectionId);
+		return false;
+	}
+
+	return DispatchMessage(JsonObject, Message.Num());
+}
+
+bool FMcpClientConnection::DispatchMessage(const TSharedPtr<FJsonObject>& JsonObject, int32 MessageBytes)
+{
+	FString ClientId;
+	if (JsonObject->HasField(TEXT("id")) && !SerializeClientId(JsonObject->TryGetField(TEXT("id")), ClientId))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: [%u] Ignoring non-scalar 'id' field"), ConnectionId);
+	}
+
+	FString CommandType;
+	if (!JsonObject->TryGetStringField(TEXT("type"), CommandType))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FMcpClientConnection: [%u] Missing 'type' field"), ConnectionId);
+		if (ClientId.IsEmpty())
+		{
+			return false;
+		}
+		return SendResponse(ClientId, TEXT("{\"status\":\"error\",\"error\":\"Missing 'type' field\"}"));
+	}
+
+	TSharedPtr<FJsonObject> Params;
+	if (JsonObject->HasField(TEXT("params")))
+	{
+		Params = JsonObject->GetObjectField(TEXT("params"));
+	}
+	else
+	{
+		Params = MakeShared<FJsonObject>();
+	}
+
+	// Connection-level commands never reach the game thread
+	if (CommandType == TEXT("negotiate"))
+	{
+		return HandleNegotiate(ClientId, Params);
+	}
+	if (CommandType == TEXT("cancel"))
+	{
+		return HandleCancel(ClientId, Params);
+	}
+	if (CommandType == TEXT("ping"))
+	{
+		return HandlePing(ClientId);
+	}
+	if (CommandType == TEXT("subscribe"))
+	{
+		return HandleSubscribe(ClientId, Params);
+	}
+	if (CommandType == TEXT("unsubscribe"))
+	{
+		return HandleUnsubscribe(ClientId, Params);
+	}
+
+	// Partial results need an id to be matched, so untagged requests never stream
+	bool bStream = false;
+	FMcpResponseStreamPtr Stream;
+	if (!ClientId.IsEmpty() && JsonObject->TryGetBoolField(TEXT("stream"), bStream) && bStream)
+	{
+		Stream = MakeShared<FMcpResponseStream, ESPMode::ThreadSafe>(CompletionSignal);
+	}
+
+	// Relative to receipt, so client and editor clocks never need to agree
+	double Deadline = 0.0;
+	double DeadlineMs = 0.0;
+	if (JsonObject->TryGetNumberField(TEXT("deadline_ms"), DeadlineMs) && DeadlineMs > 0.0)
+	{
+		Deadline = FPlatformTime::Seconds() + DeadlineMs / 1000.0;
+	}
+	FMcpCancellationTokenPtr Cancellation = MakeShared<FMcpCancellationToken, ESPMode::ThreadSafe>(Deadline);
+
+	// Stays the same across a client's retries of one logical request
+	FString IdempotencyKey;
+	JsonObject->TryGetStringField(TEXT("idempotency_key"), IdempotencyKey);
+
+	CommandsReceived++;
+	const FMcpCommandInfo* Command = Bridge->FindCommand(CommandType);
+	Bridge->GetServerStats().RecordReceived(Command, MessageBytes);
+
+	bool bEnqueued = false;
+	{
+		// Register under the lock so the writer can never sweep before the request is known
+		FScopeLock Lock(&InFlightLock);
+
+		uint32 RequestId;
+		FMcpResponseSlotPtr ResponseSlot = Bridge->EnqueueCommand(CommandType, Params, RequestId, CompletionSignal, Stream, Encoding, ConnectionId, Cancellation,
+			IdempotencyKey);
+		bEnqueued = ResponseSlot.IsValid();
+		if (bEnqueued)
+		{
+			InFlightRequests.Add(RequestId, FMcpInFlightRequest(ClientId, CommandType, Command, Stream, Cancellation, ResponseSlot));
+			InFlightCount = InFlightRequests.Num();
+
+			if (ClientId.IsEmpty())
+			{
+				bAwaitingUntaggedResponse = true;
+			}
+		}
+	}
+
+	if (!bEnqueued)
+	{
+		CommandsRejected++;
+		return SendResponse(ClientId, TEXT("{\"status\":\"error\",\"error\":\"Server busy, command queue full\"}"));
+	}
+
+	return true;
+}
+
+bool FMcpClientConnection::HandleCancel(const FString& ClientId, const TSharedPtr<FJsonObject>& Params)
+{
+	FString TargetId;
+	if (!SerializeClientId(Params->TryGetField(TEXT("id")), TargetId))
+	{
+		return SendResponse(ClientId, TEXT("{\"status\":\"error\",\"error\":\"Missing 'id' parameter\"}"));
+	}
+
+	bool bCancelled = false;
+	{
+		FScopeLock Lock(&InFlightLock);
+		for (const TPair<uint32, FMcpInFlightRequest>& Pair : InFlightRequests)
+		{
+			if (Pair.Value.ClientId == TargetId)
+			{
+				// Still answered: "Cancelled" if it had not started, otherwise whatever the handler had when it stopped
+				Pair.Value.Cancellation->Cancel();
+				bCancelled = true;
+			}
+		}
+	}
+
+	return SendResponse(ClientId, FString::Printf(TEXT("{\"status\":\"success\",\"result\":{\"cancelled\":%s}}"),
+		bCancelled ? TEXT("true") : TEXT("false")));
+}
+
+bool FMcpClientConnection::HandlePing(const FString& ClientId)
+{
+	// Answered here so a busy game thread cannot make a health check time out
+	return SendResponse(ClientId, FString::Printf(TEXT("{\"status\":\"success\",\"result\":{\"message\":\"pong\",\"success\":true,\"pending_commands\":%d}}"),
+		Bridge->GetPendingCommandCount()));
+}
+
+bool FMcpClientConnection::HandleSubscribe(const FString& ClientId, const TSharedPtr<FJsonObject>& Params)
+{
+	// Event frames carry the subscribe id, so an untagged subscription could never be told apart
+	if (ClientId.IsEmpty())
+	{
+		return SendResponse(ClientId, TEXT("{\"status\":\"error\",\"error\":\"subscribe requires an 'id'\"}"));
+	}
+
+	EMcpEventTopic Topics = EMcpEventTopic::All;
+	const TArray<TSharedPtr<FJsonValue>>* TopicValues = nullptr;
+	if (Params->TryGetArrayField(TEXT("topics"), TopicValues))
+	{
+		Topics = EMcpEventTopic::None;
+		for (const TSharedPtr<FJsonValue>& TopicValue : *TopicValues)
+		{
+			EMcpEventTopic Topic;
+			if (!McpEvents::ParseTopic(TopicValue->AsString(), Topic))
+			{
+				return SendResponse(ClientId, FString::Printf(TEXT("{\"status\":\"error\",\"error\":\"Unknown topic: %s\"}"),
+					*TopicValue->AsString().ReplaceCharWithEscapedChar()));
+			}
+			Topics |= Topic;
+		}
+	}
+
+	{
+		FScopeLock Lock(&InFlightLock);
+		if (Subscriptions.Contains(ClientId))
+		{
+			return SendResponse(ClientId, TEXT("{\"status\":\"error\",\"error\":\"Already subscribed with this id\"}"));
+		}
+	}
+
+	TArray<FString> TopicNames;
+	for (const TSharedPtr<FJsonValue>& Name : McpEvents::TopicNames(Topics))
+	{
+		TopicNames.Add(FString::Printf(TEXT("\"%s\""), *Name->AsString()));
+	}
+	const FString Response = FString::Printf(TEXT("{\"status\":\"success\",\"result\":{\"topics\":[%s],\"success\":true}}"),
+		*FString::Join(TopicNames, TEXT(",")));
+
+	// Confirm before registering, so the confirmation always precedes the first event frame
+	if (!SendResponse(ClientId, Response))
+	{
+		return false;
+	}
+
+	FMcpResponseStreamPtr Events = MakeShared<FMcpResponseStream, ESPMode::ThreadSafe>(CompletionSignal);
+	{
+		FScopeLock Lock(&InFlightLock);
+		Subscriptions.Add(ClientId, Events);
+	}
+	Bridge->Subscribe(Events, Topics, Encoding);
+
+	UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: [%u] Subscribed %s to editor events"), ConnectionId, *ClientId);
+	return true;
+}
+
+bool FMcpClientConnection::HandleUnsubscribe(const FString& ClientId, const TSharedPtr<FJsonObject>& Params)
+{
+	FString TargetId;
+	if (!SerializeClientId(Params->TryGetField(TEXT("id")), TargetId))
+	{
+		return SendResponse(ClientId, TEXT("{\"status\":\"error\",\"error\":\"Missing 'id' parameter\"}"));
+	}
+
+	FMcpResponseStreamPtr Events;
+	{
+		// Event frames already queued for it are dropped with the stream
+		FScopeLock Lock(&InFlightLock);
+		Subscriptions.RemoveAndCopyValue(TargetId, Events);
+	}
+	if (Events.IsValid())
+	{
+		Bridge->Unsubscribe(Events);
+	}
+
+	return SendResponse(ClientId, FString::Printf(TEXT("{\"status\":\"success\",\"result\":{\"unsubscribed\":%s}}"),
+		Events.IsValid() ? TEXT("true") : TEXT("false")));
+}
+
+bool FMcpClientConnection::HandleNegotiate(const FString& ClientId, const TSharedPtr<FJsonObject>& Params)
+{
+	{
+		// Responses already on their way would be framed inconsistently, and events are encoded for the current encoding
+		FScopeLock Lock(&InFlightLock);
+		if (InFlightRequests.Num() > 0 || Subscriptions.Num() > 0)
+		{
+			return SendResponse(ClientId, TEXT("{\"status\":\"error\",\"error\":\"negotiate must be sent while no requests are in flight and nothing is subscribed\"}"));
+		}
+	}
+
+	EMcpFraming RequestedFraming = Framing;
+	FString FramingName;
+	if (Params->TryGetStringField(TEXT("framing"), FramingName) && !McpFraming::FromString(FramingName, RequestedFraming))
+	{
+		return SendResponse(ClientId, FString::Printf(TEXT("{\"status\":\"error\",\"error\":\"Unsupported framing: %s\"}"),
+			*FramingName.ReplaceCharWithEscapedChar()));
+	}
+
+	// Binary payloads need length-prefixed framing; a newline connection always falls back to JSON
+	EMcpEncoding RequestedEncoding = EMcpEncoding::Json;
+	FString EncodingName;
+	if (Params->TryGetStringField(TEXT("encoding"), EncodingName) && !McpEncoding::FromString(EncodingName, RequestedEncoding))
+	{
+		return SendResponse(ClientId, FString::Printf(TEXT("{\"status\":\"error\",\"error\":\"Unsupported encoding: %s\"}"),
+			*EncodingName.ReplaceCharWithEscapedChar()));
+	}
+	if (RequestedFraming != EMcpFraming::LengthPrefixed)
+	{
+		RequestedEncoding = EMcpEncoding::Json;
+	}
+
+	// Client lists codecs in preference order; the first one this build supports wins.
+	// Compressed frames are binary, so they are only possible with length-prefixed framing.
+	EMcpCompression RequestedCompression = EMcpCompression::None;
+	if (RequestedFraming == EMcpFraming::LengthPrefixed)
+	{
+		TArray<FString> CompressionNames;
+		Params->TryGetStringArrayField(TEXT("compression"), CompressionNames);
+
+		FString CompressionName;
+		if (Params->TryGetStringField(TEXT("compression"), CompressionName))
+		{
+			CompressionNames.Add(CompressionName);
+		}
+
+		for (const FString& Name : CompressionNames)
+		{
+			if (McpFraming::FromString(Name, RequestedCompression))
+			{
+				break;
+			}
+			RequestedCompression = EMcpCompression::None;
+		}
+	}
+
+	int32 RequestedThreshold = CompressionThreshold;
+	if (Params->TryGetNumberField(TEXT("compression_threshold"), RequestedThreshold))
+	{
+		RequestedThreshold = FMath::Max(RequestedThreshold, MCP_MIN_COMPRESSION_THRESHOLD);
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetStringField(TEXT("framing"), McpFraming::ToString(RequestedFraming));
+	ResultObj->SetStringField(TEXT("encoding"), McpEncoding::ToString(RequestedEncoding));
+	ResultObj->SetStringField(TEXT("compression"), McpFraming::ToString(RequestedCompression));
+	ResultObj->SetNumberField(TEXT("compression_threshold"), RequestedThreshold);
+	ResultObj->SetNumberField(TEXT("max_message_size"), MCP_MAX_MESSAGE_SIZE);
+	ResultObj->SetNumberField(TEXT("max_in_flight"), MCP_MAX_INFLIGHT_PER_CONNECTION);
+
+	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+	ResponseJson->SetObjectField(TEXT("result"), ResultObj);
+
+	// The acknowledgement goes out in the old framing and encoding; everything after it uses the
+	// new ones. SendLock is held across the switch (SendResponse re-enters it).
+	FScopeLock Lock(&SendLock);
+
+	FMcpResponseWriter Writer(nullptr, Encoding);
+	Writer.WriteResponse(ResponseJson);
+	const bool bSent = SendResponse(ClientId, Writer.MoveBody());
+
+	if (Framing != RequestedFraming || Encoding != RequestedEncoding || Compression != RequestedCompression)
+	{
+		UE_LOG(LogTemp, Display, TEXT("FMcpClientConnection: [%u] Framing switched to %s (encoding: %s, compression: %s, threshold %d)"), ConnectionId,
+			McpFraming::ToString(RequestedFraming), McpEncoding::ToString(RequestedEncoding), McpFraming::ToString(RequestedCompression), RequestedThreshold);
+	}
+	Framing = RequestedFraming;
+	Encoding = RequestedEncoding;
+	Compression = RequestedCompression;
+	CompressionThreshold = RequestedThreshold;
+	return bSent;
+}
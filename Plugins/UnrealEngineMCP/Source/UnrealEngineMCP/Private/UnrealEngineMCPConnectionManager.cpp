@@ -0,0 +1,126 @@
+#include "UnrealEngineMCPConnectionManager.h"
+#include "UnrealEngineMCPConnection.h"
+#include "Dom/JsonObject.h"
+
+FMcpConnectionManager::FMcpConnectionManager(UUnrealEngineMCPBridge* InBridge, int32 InMaxConnections)
+	: Bridge(InBridge)
+	, MaxConnections(InMaxConnections)
+	, NextConnectionId(1)
+	, TotalAccepted(0)
+	, TotalRejected(0)
+{
+}
+
+FMcpConnectionManager::~FMcpConnectionManager()
+{
+	CloseAll();
+}
+
+bool FMcpConnectionManager::AddConnection(TSharedPtr<FMcpStreamSocket> ClientSocket)
+{
+	if (!ClientSocket.IsValid())
+	{
+		return false;
+	}
+
+	const FString RemoteAddress = FString::Printf(TEXT("%s:%s"), ClientSocket->GetTransportName(), *ClientSocket->GetRemoteAddress());
+
+	FScopeLock Lock(&ConnectionsLock);
+
+	if (Connections.Num() >= MaxConnections)
+	{
+		TotalRejected++;
+		UE_LOG(LogTemp, Warning, TEXT("FMcpConnectionManager: Connection limit reached (%d), rejecting %s"),
+			MaxConnections, *RemoteAddress);
+		return false;
+	}
+
+	TSharedPtr<FMcpClientConnection> Connection = MakeShared<FMcpClientConnection>(
+		Bridge, NextConnectionId++, ClientSocket);
+
+	if (!Connection->Start())
+	{
+		return false;
+	}
+
+	Connections.Add(Connection);
+	TotalAccepted++;
+
+	UE_LOG(LogTemp, Display, TEXT("FMcpConnectionManager: Accepted connection %u from %s (%d/%d active)"),
+		Connection->GetConnectionId(), *RemoteAddress, Connections.Num(), MaxConnections);
+	return true;
+}
+
+void FMcpConnectionManager::ReapFinishedConnections()
+{
+	TArray<TSharedPtr<FMcpClientConnection>> Finished;
+
+	{
+		FScopeLock Lock(&ConnectionsLock);
+		for (int32 i = Connections.Num() - 1; i >= 0; --i)
+		{
+			if (Connections[i]->IsFinished())
+			{
+				Finished.Add(Connections[i]);
+				Connections.RemoveAtSwap(i);
+			}
+		}
+	}
+
+	// Join outside the lock
+	for (const TSharedPtr<FMcpClientConnection>& Connection : Finished)
+	{
+		Connection->Shutdown();
+	}
+}
+
+void FMcpConnectionManager::CloseAll()
+{
+	TArray<TSharedPtr<FMcpClientConnection>> ToClose;
+
+	{
+		FScopeLock Lock(&ConnectionsLock);
+		ToClose = MoveTemp(Connections);
+		Connections.Reset();
+	}
+
+	for (const TSharedPtr<FMcpClientConnection>& Connection : ToClose)
+	{
+		Connection->Shutdown();
+	}
+}
+
+int32 FMcpConnectionManager::GetConnectionCount() const
+{
+	FScopeLock Lock(&ConnectionsLock);
+	return Connections.Num();
+}
+
+TSharedPtr<FJsonObject> FMcpConnectionManager::GetStatsJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> ConnectionsArray;
+	int32 TotalAcceptedSnapshot = 0;
+	int32 TotalRejectedSnapshot = 0;
+
+	{
+		FScopeLock Lock(&ConnectionsLock);
+		for (const TSharedPtr<FMcpClientConnection>& Connection : Connections)
+		{
+			if (!Connection->IsFinished())
+			{
+				ConnectionsArray.Add(MakeShared<FJsonValueObject>(Connection->GetStats().ToJson()));
+			}
+		}
+		TotalAcceptedSnapshot = TotalAccepted;
+		TotalRejectedSnapshot = TotalRejected;
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetBoolField(TEXT("success"), true);
+	ResultObj->SetArrayField(TEXT("connections"), ConnectionsArray);
+	ResultObj->SetNumberField(TEXT("connection_count"), ConnectionsArray.Num());
+	ResultObj->SetNumberField(TEXT("max_connections"), MaxConnections);
+	ResultObj->SetNumberField(TEXT("total_accepted"), TotalAcceptedSnapshot);
+	ResultObj->SetNumberField(TEXT("total_rejected"), TotalRejectedSnapshot);
+	return ResultObj;
+}
@@ -0,0 +1,465 @@
+#include "UnrealEngineMCPEncoding.h"
+#include "CborReader.h"
+#include "CborWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Nesting limit for CBOR requests (the reader recurses per container)
+#define MCP_MAX_CBOR_DEPTH 64
+
+namespace
+{
+	TSharedPtr<FJsonValue> ReadCborValue(FCborReader& Reader, const FCborContext& Context, int32 Depth)
+	{
+		if (Depth > MCP_MAX_CBOR_DEPTH)
+		{
+			return nullptr;
+		}
+
+		switch (Context.MajorType())
+		{
+		case ECborCode::Uint:
+			return MakeShared<FJsonValueNumber>((double)Context.AsUInt());
+
+		case ECborCode::Int:
+			return MakeShared<FJsonValueNumber>((double)Context.AsInt());
+
+		case ECborCode::TextString:
+			return MakeShared<FJsonValueString>(Context.AsString());
+
+		case ECborCode::Array:
+		{
+			TArray<TSharedPtr<FJsonValue>> Items;
+			FCborContext ItemContext;
+			while (Reader.ReadNext(ItemContext) && !ItemContext.IsBreak())
+			{
+				TSharedPtr<FJsonValue> Item = ReadCborValue(Reader, ItemContext, Depth + 1);
+				if (!Item.IsValid())
+				{
+					return nullptr;
+				}
+				Items.Add(Item);
+			}
+			return ItemContext.IsBreak() ? MakeShared<FJsonValueArray>(Items) : nullptr;
+		}
+
+		case ECborCode::Map:
+		{
+			TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+			FCborContext KeyContext;
+			while (Reader.ReadNext(KeyContext) && !KeyContext.IsBreak())
+			{
+				FCborContext ValueContext;
+				if (KeyContext.MajorType() != ECborCode::TextString || !Reader.ReadNext(ValueContext))
+				{
+					return nullptr;
+				}
+
+				TSharedPtr<FJsonValue> Value = ReadCborValue(Reader, ValueContext, Depth + 1);
+				if (!Value.IsValid())
+				{
+					return nullptr;
+				}
+				Object->SetField(KeyContext.AsString(), Value);
+			}
+			return KeyContext.IsBreak() ? MakeShared<FJsonValueObject>(Object) : nullptr;
+		}
+
+		case ECborCode::Prim:
+			switch (Context.AdditionalValue())
+			{
+			case ECborCode::False:
+				return MakeShared<FJsonValueBoolean>(false);
+			case ECborCode::True:
+				return MakeShared<FJsonValueBoolean>(true);
+			case ECborCode::Null:
+			case ECborCode::Undefined:
+				return MakeShared<FJsonValueNull>();
+			case ECborCode::Value_4Bytes:
+				return MakeShared<FJsonValueNumber>(Context.AsFloat());
+			case ECborCode::Value_8Bytes:
+				return MakeShared<FJsonValueNumber>(Context.AsDouble());
+			default:
+				return nullptr;
+			}
+
+		default:
+			// Byte strings and tags have no JSON equivalent
+			return nullptr;
+		}
+	}
+}
+
+const TCHAR* McpEncoding::ToString(EMcpEncoding Encoding)
+{
+	switch (Encoding)
+	{
+	case EMcpEncoding::Cbor:
+		return TEXT("cbor");
+	case EMcpEncoding::Json:
+	default:
+		return TEXT("json");
+	}
+}
+
+bool McpEncoding::FromString(const FString& Name, EMcpEncoding& OutEncoding)
+{
+	if (Name.Equals(TEXT("cbor"), ESearchCase::IgnoreCase))
+	{
+		OutEncoding = EMcpEncoding::Cbor;
+		return true;
+	}
+	if (Name.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+	{
+		OutEncoding = EMcpEncoding::Json;
+		return true;
+	}
+	return false;
+}
+
+bool McpEncoding::ReadCborObject(TArrayView<const uint8> Data, TSharedPtr<FJsonObject>& OutObject)
+{
+	FMemoryReaderView Archive(Data);
+	FCborReader Reader(&Archive, ECborEndianness::StandardCompliant);
+
+	FCborContext Context;
+	if (!Reader.ReadNext(Context) || Context.MajorType() != ECborCode::Map)
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonValue> Value = ReadCborValue(Reader, Context, 0);
+	if (!Value.IsValid())
+	{
+		return false;
+	}
+
+	OutObject = Value->AsObject();
+	return OutObject.IsValid();
+}
+
+void McpEncoding::AppendIdPrefix(EMcpEncoding Encoding, const FString& ClientId, TArray<uint8>& OutBytes)
+{
+	if (Encoding == EMcpEncoding::Json)
+	{
+		FTCHARToUTF8 IdPrefix(*FString::Printf(TEXT("{\"id\":%s,"), *ClientId));
+		OutBytes.Append((const uint8*)IdPrefix.Get(), IdPrefix.Length());
+		return;
+	}
+
+	FMemoryWriter Archive(OutBytes, false, true);
+	FCborWriter Writer(&Archive, ECborEndianness::StandardCompliant);
+	Writer.WriteContainerStart(ECborCode::Map, -1);
+	Writer.WriteValue(FString(TEXT("id")));
+
+	// ClientId holds the id as JSON text - a quoted string or a number
+	if (ClientId.StartsWith(TEXT("\"")))
+	{
+		Writer.WriteValue(ClientId.Mid(1, ClientId.Len() - 2).ReplaceEscapedCharWithChar());
+	}
+	else if (ClientId.Contains(TEXT(".")) || ClientId.Contains(TEXT("e"), ESearchCase::IgnoreCase))
+	{
+		Writer.WriteValue(FCString::Atod(*ClientId));
+	}
+	else
+	{
+		Writer.WriteValue(FCString::Atoi64(*ClientId));
+	}
+}
+
+FMcpValueWriter::FMcpValueWriter(FArchive& Archive, EMcpEncoding InEncoding)
+	: Encoding(InEncoding)
+{
+	if (Encoding == EMcpEncoding::Cbor)
+	{
+		CborWriter = MakeUnique<FCborWriter>(&Archive, ECborEndianness::StandardCompliant);
+	}
+	else
+	{
+		JsonWriter = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Archive);
+	}
+}
+
+FMcpValueWriter::~FMcpValueWriter()
+{
+}
+
+void FMcpValueWriter::WriteObjectStart()
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteContainerStart(ECborCode::Map, -1);
+	}
+	else
+	{
+		JsonWriter->WriteObjectStart();
+	}
+}
+
+void FMcpValueWriter::WriteObjectStart(const FString& Name)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Name);
+		CborWriter->WriteContainerStart(ECborCode::Map, -1);
+	}
+	else
+	{
+		JsonWriter->WriteObjectStart(Name);
+	}
+}
+
+void FMcpValueWriter::WriteObjectEnd()
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteContainerEnd();
+	}
+	else
+	{
+		JsonWriter->WriteObjectEnd();
+	}
+}
+
+void FMcpValueWriter::WriteArrayStart()
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteContainerStart(ECborCode::Array, -1);
+	}
+	else
+	{
+		JsonWriter->WriteArrayStart();
+	}
+}
+
+void FMcpValueWriter::WriteArrayStart(const FString& Name)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Name);
+		CborWriter->WriteContainerStart(ECborCode::Array, -1);
+	}
+	else
+	{
+		JsonWriter->WriteArrayStart(Name);
+	}
+}
+
+void FMcpValueWriter::WriteArrayEnd()
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteContainerEnd();
+	}
+	else
+	{
+		JsonWriter->WriteArrayEnd();
+	}
+}
+
+void FMcpValueWriter::WriteValue(const FString& Name, const FString& Value)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Name);
+		CborWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Name, Value);
+	}
+}
+
+void FMcpValueWriter::WriteValue(const FString& Name, const TCHAR* Value)
+{
+	WriteValue(Name, FString(Value));
+}
+
+void FMcpValueWriter::WriteValue(const FString& Name, bool Value)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Name);
+		CborWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Name, Value);
+	}
+}
+
+void FMcpValueWriter::WriteValue(const FString& Name, int32 Value)
+{
+	WriteValue(Name, (int64)Value);
+}
+
+void FMcpValueWriter::WriteValue(const FString& Name, int64 Value)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Name);
+		CborWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Name, Value);
+	}
+}
+
+void FMcpValueWriter::WriteValue(const FString& Name, double Value)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Name);
+		WriteCborNumber(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Name, Value);
+	}
+}
+
+void FMcpValueWriter::WriteValue(const FString& Value)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Value);
+	}
+}
+
+void FMcpValueWriter::WriteValue(bool Value)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Value);
+	}
+}
+
+void FMcpValueWriter::WriteValue(int32 Value)
+{
+	WriteValue((int64)Value);
+}
+
+void FMcpValueWriter::WriteValue(int64 Value)
+{
+	if (CborWriter)
+	{
+		CborWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Value);
+	}
+}
+
+void FMcpValueWriter::WriteValue(double Value)
+{
+	if (CborWriter)
+	{
+		WriteCborNumber(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Value);
+	}
+}
+
+void FMcpValueWriter::WriteJsonValue(const FString& Name, const TSharedPtr<FJsonValue>& Value)
+{
+	if (!CborWriter)
+	{
+		FJsonSerializer::Serialize(Value, Name, JsonWriter.ToSharedRef(), false);
+		return;
+	}
+
+	if (!Name.IsEmpty())
+	{
+		CborWriter->WriteValue(Name);
+	}
+	WriteCborValue(Value);
+}
+
+void FMcpValueWriter::Close()
+{
+	if (JsonWriter.IsValid())
+	{
+		JsonWriter->Close();
+	}
+}
+
+void FMcpValueWriter::WriteCborNumber(double Value)
+{
+	// Same values the JSON writer would print: integral numbers as integers, the rest as the
+	// smallest float that holds them exactly (most editor coordinates fit in single precision)
+	if (Value == FMath::FloorToDouble(Value) && FMath::Abs(Value) < 9007199254740992.0)
+	{
+		CborWriter->WriteValue((int64)Value);
+	}
+	else if ((double)(float)Value == Value)
+	{
+		CborWriter->WriteValue((float)Value);
+	}
+	else
+	{
+		CborWriter->WriteValue(Value);
+	}
+}
+
+void FMcpValueWriter::WriteCborValue(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		CborWriter->WriteNull();
+		return;
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+		CborWriter->WriteValue(Value->AsString());
+		break;
+
+	case EJson::Number:
+		WriteCborNumber(Value->AsNumber());
+		break;
+
+	case EJson::Boolean:
+		CborWriter->WriteValue(Value->AsBool());
+		break;
+
+	case EJson::Array:
+		CborWriter->WriteContainerStart(ECborCode::Array, -1);
+		for (const TSharedPtr<FJsonValue>& Item : Value->AsArray())
+		{
+			WriteCborValue(Item);
+		}
+		CborWriter->WriteContainerEnd();
+		break;
+
+	case EJson::Object:
+		CborWriter->WriteContainerStart(ECborCode::Map, -1);
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+		{
+			CborWriter->WriteValue(Field.Key);
+			WriteCborValue(Field.Value);
+		}
+		CborWriter->WriteContainerEnd();
+		break;
+
+	case EJson::None:
+	case EJson::Null:
+	default:
+		CborWriter->WriteNull();
+		break;
+	}
+}
@@ -0,0 +1,465 @@
+#include "UnrealEngineMCPEvents.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/CoreDelegates.h"
+#include "Dom/JsonValue.h"
+
+#define MCP_MAX_EVENTS_PER_FRAME 2000  // Beyond this a frame reports "dropped" and the client should re-scan
+
+namespace
+{
+	TSharedPtr<FJsonValue> MakeLocationValue(const AActor* Actor)
+	{
+		const FVector Location = Actor->GetActorLocation();
+		TArray<TSharedPtr<FJsonValue>> LocationArray;
+		LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
+		LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
+		LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
+		return MakeShared<FJsonValueArray>(LocationArray);
+	}
+
+	TSharedPtr<FJsonValue> MakeEvent(const TCHAR* Type, TFunctionRef<void(FJsonObject&)> Fill)
+	{
+		TSharedPtr<FJsonObject> EventObj = MakeShared<FJsonObject>();
+		EventObj->SetStringField(TEXT("type"), Type);
+		Fill(*EventObj);
+		return MakeShared<FJsonValueObject>(EventObj);
+	}
+}
+
+bool McpEvents::ParseTopic(const FString& Name, EMcpEventTopic& OutTopic)
+{
+	if (Name == TEXT("actors"))
+	{
+		OutTopic = EMcpEventTopic::Actors;
+	}
+	else if (Name == TEXT("assets"))
+	{
+		OutTopic = EMcpEventTopic::Assets;
+	}
+	else if (Name == TEXT("blueprints"))
+	{
+		OutTopic = EMcpEventTopic::Blueprints;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+TArray<TSharedPtr<FJsonValue>> McpEvents::TopicNames(EMcpEventTopic Topics)
+{
+	TArray<TSharedPtr<FJsonValue>> Names;
+	if (EnumHasAnyFlags(Topics, EMcpEventTopic::Actors))
+	{
+		Names.Add(MakeShared<FJsonValueString>(TEXT("actors")));
+	}
+	if (EnumHasAnyFlags(Topics, EMcpEventTopic::Assets))
+	{
+		Names.Add(MakeShared<FJsonValueString>(TEXT("assets")));
+	}
+	if (EnumHasAnyFlags(Topics, EMcpEventTopic::Blueprints))
+	{
+		Names.Add(MakeShared<FJsonValueString>(TEXT("blueprints")));
+	}
+	return Names;
+}
+
+FMcpEventHub::FMcpEventHub()
+	: SubscriberCount(0)
+	, bStarted(false)
+{
+}
+
+FMcpEventHub::~FMcpEventHub()
+{
+	Stop();
+}
+
+void FMcpEventHub::Start()
+{
+	check(IsInGameThread());
+	if (bStarted || !GEngine)
+	{
+		return;
+	}
+
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMcpEventHub::HandleActorAdded);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMcpEventHub::HandleActorDeleted);
+	ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMcpEventHub::HandleActorMoved);
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FMcpEventHub::HandleActorLabelChanged);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMcpEventHub::HandleAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMcpEventHub::HandleAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMcpEventHub::HandleAssetRenamed);
+
+	if (GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FMcpEventHub::HandleBlueprintPreCompile);
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMcpEventHub::HandleBlueprintCompiled);
+	}
+
+	bStarted = true;
+}
+
+void FMcpEventHub::Stop()
+{
+	if (!bStarted)
+	{
+		return;
+	}
+
+	// The engine may already be tearing down on editor exit
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+
+	ActorChanges.Empty();
+	AssetChanges.Empty();
+	CompilingBlueprints.Empty();
+	CompiledBlueprints.Empty();
+
+	{
+		FScopeLock Lock(&SubscribersLock);
+		Subscribers.Empty();
+		SubscriberCount = 0;
+	}
+
+	bStarted = false;
+}
+
+void FMcpEventHub::Subscribe(const FMcpResponseStreamPtr& Stream, EMcpEventTopic Topics, EMcpEncoding Encoding)
+{
+	FScopeLock Lock(&SubscribersLock);
+	Subscribers.Add({ Stream, Topics, Encoding, 0 });
+	SubscriberCount = Subscribers.Num();
+}
+
+void FMcpEventHub::Unsubscribe(const FMcpResponseStreamPtr& Stream)
+{
+	FScopeLock Lock(&SubscribersLock);
+	Subscribers.RemoveAll([&Stream](const FSubscriber& Subscriber)
+	{
+		return Subscriber.Stream.Pin() == Stream;
+	});
+	SubscriberCount = Subscribers.Num();
+}
+
+void FMcpEventHub::HandleActorAdded(AActor* Actor)
+{
+	RecordActor(Actor, Added);
+}
+
+void FMcpEventHub::HandleActorDeleted(AActor* Actor)
+{
+	RecordActor(Actor, Removed);
+}
+
+void FMcpEventHub::HandleActorMoved(AActor* Actor)
+{
+	RecordActor(Actor, Moved);
+}
+
+void FMcpEventHub::HandleActorLabelChanged(AActor* Actor)
+{
+	RecordActor(Actor, Renamed);
+}
+
+void FMcpEventHub::RecordActor(AActor* Actor, EChange Change)
+{
+	if (!IsRecording() || !Actor || Actor->HasAnyFlags(RF_Transient))
+	{
+		return;
+	}
+
+	// Preview scenes, PIE and editor tools spawn actors of their own
+	const UWorld* World = Actor->GetWorld();
+	if (!World || World->WorldType != EWorldType::Editor)
+	{
+		return;
+	}
+
+	const FObjectKey Key(Actor);
+	FActorChange* Existing = ActorChanges.Find(Key);
+
+	if (Change == Removed && Existing && (Existing->Changes & Added))
+	{
+		// Never seen by a subscriber
+		ActorChanges.Remove(Key);
+		return;
+	}
+
+	FActorChange& Entry = Existing ? *Existing : ActorChanges.Add(Key);
+	Entry.Actor = Actor;
+	Entry.Name = Actor->GetName();
+	Entry.Label = Actor->GetActorLabel();
+
+	if (Change == Added || Change == Removed)
+	{
+		Entry.Changes = Change;
+	}
+	else if (!(Entry.Changes & Added))
+	{
+		// A new actor's current label and location go out with its "actor_added"
+		Entry.Changes |= Change;
+	}
+}
+
+void FMcpEventHub::HandleAssetAdded(const FAssetData& AssetData)
+{
+	RecordAsset(AssetData, Added);
+}
+
+void FMcpEventHub::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	RecordAsset(AssetData, Removed);
+}
+
+void FMcpEventHub::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	// Follow the asset to its new path, keeping what was already recorded for it
+	FAssetChange Entry;
+	AssetChanges.RemoveAndCopyValue(OldObjectPath, Entry);
+	if (!(Entry.Changes & Added))
+	{
+		Entry.Changes |= Renamed;
+		if (Entry.OldPath.IsEmpty())
+		{
+			Entry.OldPath = OldObjectPath;
+		}
+	}
+	Entry.Class = AssetData.AssetClassPath.GetAssetName().ToString();
+	AssetChanges.Add(AssetData.GetObjectPathString(), Entry);
+}
+
+void FMcpEventHub::RecordAsset(const FAssetData& AssetData, EChange Change)
+{
+	if (!IsRecording() || AssetData.PackageName.ToString().StartsWith(TEXT("/Temp/")))
+	{
+		return;
+	}
+
+	// The initial scan reports every asset in the project
+	if (FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().IsLoadingAssets())
+	{
+		return;
+	}
+
+	const FString Path = AssetData.GetObjectPathString();
+	FAssetChange* Existing = AssetChanges.Find(Path);
+
+	if (Change == Removed && Existing && (Existing->Changes & Added))
+	{
+		AssetChanges.Remove(Path);
+		return;
+	}
+
+	FAssetChange& Entry = Existing ? *Existing : AssetChanges.Add(Path);
+	Entry.Class = AssetData.AssetClassPath.GetAssetName().ToString();
+	Entry.Changes = Change;
+	Entry.OldPath.Empty();
+}
+
+void FMcpEventHub::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (IsRecording() && Blueprint)
+	{
+		CompilingBlueprints.AddUnique(Blueprint);
+	}
+}
+
+void FMcpEventHub::HandleBlueprintCompiled()
+{
+	// Reported without the blueprint, so pair it with the pre-compile notifications
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : CompilingBlueprints)
+	{
+		CompiledBlueprints.AddUnique(Blueprint);
+	}
+	CompilingBlueprints.Reset();
+}
+
+void FMcpEventHub::BuildEvents(TArray<TSharedPtr<FJsonValue>>& OutActorEvents, TArray<TSharedPtr<FJsonValue>>& OutAssetEvents,
+	TArray<TSharedPtr<FJsonValue>>& OutBlueprintEvents)
+{
+	for (const TPair<FObjectKey, FActorChange>& Pair : ActorChanges)
+	{
+		const FActorChange& Change = Pair.Value;
+		const AActor* Actor = Change.Actor.Get();
+
+		if (Change.Changes & Removed)
+		{
+			OutActorEvents.Add(MakeEvent(TEXT("actor_removed"), [&Change](FJsonObject& EventObj)
+			{
+				EventObj.SetStringField(TEXT("name"), Change.Name);
+				EventObj.SetStringField(TEXT("label"), Change.Label);
+			}));
+			continue;
+		}
+
+		// Destroyed since without a delete notification (e.g. undo of its creation)
+		if (!Actor)
+		{
+			continue;
+		}
+
+		if (Change.Changes & Added)
+		{
+			OutActorEvents.Add(MakeEvent(TEXT("actor_added"), [Actor](FJsonObject& EventObj)
+			{
+				EventObj.SetStringField(TEXT("name"), Actor->GetName());
+				EventObj.SetStringField(TEXT("label"), Actor->GetActorLabel());
+				EventObj.SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+				EventObj.SetField(TEXT("location"), MakeLocationValue(Actor));
+			}));
+			continue;
+		}
+
+		if (Change.Changes & Renamed)
+		{
+			OutActorEvents.Add(MakeEvent(TEXT("actor_renamed"), [Actor](FJsonObject& EventObj)
+			{
+				EventObj.SetStringField(TEXT("name"), Actor->GetName());
+				EventObj.SetStringField(TEXT("label"), Actor->GetActorLabel());
+			}));
+		}
+		if (Change.Changes & Moved)
+		{
+			OutActorEvents.Add(MakeEvent(TEXT("actor_moved"), [Actor](FJsonObject& EventObj)
+			{
+				EventObj.SetStringField(TEXT("name"), Actor->GetName());
+				EventObj.SetField(TEXT("location"), MakeLocationValue(Actor));
+			}));
+		}
+	}
+
+	for (const TPair<FString, FAssetChange>& Pair : AssetChanges)
+	{
+		const FString& Path = Pair.Key;
+		const FAssetChange& Change = Pair.Value;
+		const TCHAR* Type = (Change.Changes & Added) ? TEXT("asset_added")
+			: (Change.Changes & Removed) ? TEXT("asset_removed")
+			: TEXT("asset_renamed");
+
+		OutAssetEvents.Add(MakeEvent(Type, [&Path, &Change](FJsonObject& EventObj)
+		{
+			EventObj.SetStringField(TEXT("path"), Path);
+			EventObj.SetStringField(TEXT("class"), Change.Class);
+			if (!Change.OldPath.IsEmpty())
+			{
+				EventObj.SetStringField(TEXT("old_path"), Change.OldPath);
+			}
+		}));
+	}
+
+	for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : CompiledBlueprints)
+	{
+		if (const UBlueprint* Blueprint = WeakBlueprint.Get())
+		{
+			OutBlueprintEvents.Add(MakeEvent(TEXT("blueprint_compiled"), [Blueprint](FJsonObject& EventObj)
+			{
+				EventObj.SetStringField(TEXT("name"), Blueprint->GetName());
+				EventObj.SetStringField(TEXT("path"), Blueprint->GetPathName());
+				EventObj.SetBoolField(TEXT("has_errors"), Blueprint->Status == BS_Error);
+			}));
+		}
+	}
+}
+
+void FMcpEventHub::Flush()
+{
+	if (ActorChanges.Num() == 0 && AssetChanges.Num() == 0 && CompiledBlueprints.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ActorEvents;
+	TArray<TSharedPtr<FJsonValue>> AssetEvents;
+	TArray<TSharedPtr<FJsonValue>> BlueprintEvents;
+	BuildEvents(ActorEvents, AssetEvents, BlueprintEvents);
+
+	ActorChanges.Reset();
+	AssetChanges.Reset();
+	CompiledBlueprints.Reset();
+
+	FScopeLock Lock(&SubscribersLock);
+
+	for (int32 Index = Subscribers.Num() - 1; Index >= 0; Index--)
+	{
+		FSubscriber& Subscriber = Subscribers[Index];
+		FMcpResponseStreamPtr Stream = Subscriber.Stream.Pin();
+		if (!Stream.IsValid())
+		{
+			// Connection closed without unsubscribing
+			Subscribers.RemoveAtSwap(Index);
+			continue;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Events;
+		if (EnumHasAnyFlags(Subscriber.Topics, EMcpEventTopic::Actors))
+		{
+			Events.Append(ActorEvents);
+		}
+		if (EnumHasAnyFlags(Subscriber.Topics, EMcpEventTopic::Assets))
+		{
+			Events.Append(AssetEvents);
+		}
+		if (EnumHasAnyFlags(Subscriber.Topics, EMcpEventTopic::Blueprints))
+		{
+			Events.Append(BlueprintEvents);
+		}
+		if (Events.Num() == 0)
+		{
+			continue;
+		}
+
+		const int32 Dropped = FMath::Max(0, Events.Num() - MCP_MAX_EVENTS_PER_FRAME);
+		if (Dropped > 0)
+		{
+			Events.SetNum(MCP_MAX_EVENTS_PER_FRAME);
+		}
+
+		TSharedPtr<FJsonObject> FrameObj = MakeShared<FJsonObject>();
+		FrameObj->SetStringField(TEXT("status"), TEXT("event"));
+		FrameObj->SetNumberField(TEXT("seq"), Subscriber.NextSeq++);
+		FrameObj->SetArrayField(TEXT("events"), Events);
+		if (Dropped > 0)
+		{
+			FrameObj->SetNumberField(TEXT("dropped"), Dropped);
+		}
+
+		FMcpResponseWriter Writer(nullptr, Subscriber.Encoding);
+		Writer.WriteResponse(FrameObj);
+		Stream->PushChunk(Writer.MoveBody());
+	}
+
+	SubscriberCount = Subscribers.Num();
+}
@@ -0,0 +1,236 @@
+#include "UnrealEngineMCPFraming.h"
+#include "Misc/Compression.h"
+
+namespace
+{
+	void WriteBigEndian32(uint32 Value, uint8* Out)
+	{
+		Out[0] = (uint8)(Value >> 24);
+		Out[1] = (uint8)(Value >> 16);
+		Out[2] = (uint8)(Value >> 8);
+		Out[3] = (uint8)Value;
+	}
+
+	FName GetCompressionFormat(EMcpCompression Compression)
+	{
+		switch (Compression)
+		{
+		case EMcpCompression::LZ4:
+			return NAME_LZ4;
+		case EMcpCompression::Zlib:
+			return NAME_Zlib;
+		default:
+			return NAME_None;
+		}
+	}
+}
+
+const TCHAR* McpFraming::ToString(EMcpFraming Framing)
+{
+	switch (Framing)
+	{
+	case EMcpFraming::LengthPrefixed:
+		return TEXT("length_prefixed");
+	case EMcpFraming::Newline:
+	default:
+		return TEXT("newline");
+	}
+}
+
+bool McpFraming::FromString(const FString& Name, EMcpFraming& OutFraming)
+{
+	if (Name.Equals(TEXT("length_prefixed"), ESearchCase::IgnoreCase))
+	{
+		OutFraming = EMcpFraming::LengthPrefixed;
+		return true;
+	}
+	if (Name.Equals(TEXT("newline"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("ndjson"), ESearchCase::IgnoreCase))
+	{
+		OutFraming = EMcpFraming::Newline;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* McpFraming::ToString(EMcpCompression Compression)
+{
+	switch (Compression)
+	{
+	case EMcpCompression::LZ4:
+		return TEXT("lz4");
+	case EMcpCompression::Zlib:
+		return TEXT("zlib");
+	case EMcpCompression::None:
+	default:
+		return TEXT("none");
+	}
+}
+
+bool McpFraming::FromString(const FString& Name, EMcpCompression& OutCompression)
+{
+	if (Name.Equals(TEXT("lz4"), ESearchCase::IgnoreCase))
+	{
+		OutCompression = EMcpCompression::LZ4;
+	}
+	else if (Name.Equals(TEXT("zlib"), ESearchCase::IgnoreCase))
+	{
+		OutCompression = EMcpCompression::Zlib;
+	}
+	else if (Name.Equals(TEXT("none"), ESearchCase::IgnoreCase))
+	{
+		OutCompression = EMcpCompression::None;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+
+	return FCompression::IsFormatValid(GetCompressionFormat(OutCompression));
+}
+
+bool McpFraming::AppendCompressedFrame(const uint8* Payload, int32 PayloadSize, EMcpCompression Compression, TArray<uint8>& OutBytes)
+{
+	const FName Format = GetCompressionFormat(Compression);
+	if (Format.IsNone())
+	{
+		return false;
+	}
+
+	const int32 HeaderSize = LengthPrefixSize * 2;
+	const int32 StartIndex = OutBytes.Num();
+	int32 CompressedSize = FCompression::CompressMemoryBound(Format, PayloadSize);
+	OutBytes.AddUninitialized(HeaderSize + CompressedSize);
+
+	if (!FCompression::CompressMemory(Format, OutBytes.GetData() + StartIndex + HeaderSize, CompressedSize, Payload, PayloadSize)
+		|| HeaderSize + CompressedSize >= PayloadSize)
+	{
+		OutBytes.SetNum(StartIndex, EAllowShrinking::No);
+		return false;
+	}
+
+	OutBytes.SetNum(StartIndex + HeaderSize + CompressedSize, EAllowShrinking::No);
+	WriteBigEndian32(((uint32)(LengthPrefixSize + CompressedSize)) | CompressedFlag, OutBytes.GetData() + StartIndex);
+	WriteBigEndian32((uint32)PayloadSize, OutBytes.GetData() + StartIndex + LengthPrefixSize);
+	return true;
+}
+
+void McpFraming::AppendHeader(uint32 PayloadSize, EMcpFraming Framing, TArray<uint8>& OutBytes)
+{
+	if (Framing == EMcpFraming::LengthPrefixed)
+	{
+		const int32 StartIndex = OutBytes.AddUninitialized(LengthPrefixSize);
+		WriteBigEndian32(PayloadSize, OutBytes.GetData() + StartIndex);
+	}
+}
+
+void McpFraming::AppendTrailer(EMcpFraming Framing, TArray<uint8>& OutBytes)
+{
+	if (Framing == EMcpFraming::Newline)
+	{
+		OutBytes.Add('\n');
+	}
+}
+
+FMcpReceiveBuffer::FMcpReceiveBuffer(int32 InitialCapacity)
+	: Head(0)
+	, Tail(0)
+	, ScanOffset(0)
+{
+	Data.SetNumUninitialized(InitialCapacity);
+}
+
+uint8* FMcpReceiveBuffer::PrepareWrite(int32 MinFree, int32& OutFree)
+{
+	if (Data.Num() - Tail < MinFree)
+	{
+		Compact();
+	}
+
+	if (Data.Num() - Tail < MinFree)
+	{
+		Data.SetNumUninitialized(FMath::Max(Data.Num() * 2, Tail + MinFree));
+	}
+
+	OutFree = Data.Num() - Tail;
+	return Data.GetData() + Tail;
+}
+
+void FMcpReceiveBuffer::CommitWrite(int32 BytesWritten)
+{
+	Tail += BytesWritten;
+}
+
+EMcpFrameResult FMcpReceiveBuffer::PeekFrame(EMcpFraming Framing, int32 MaxFrameSize, TArrayView<const uint8>& OutFrame, int32& OutConsumed)
+{
+	const uint8* Start = Data.GetData() + Head;
+	const int32 Available = Num();
+
+	if (Framing == EMcpFraming::LengthPrefixed)
+	{
+		if (Available < McpFraming::LengthPrefixSize)
+		{
+			return EMcpFrameResult::Incomplete;
+		}
+
+		const uint32 Length = ((uint32)Start[0] << 24) | ((uint32)Start[1] << 16) | ((uint32)Start[2] << 8) | (uint32)Start[3];
+		if (Length > (uint32)MaxFrameSize)
+		{
+			return EMcpFrameResult::TooLarge;
+		}
+
+		if (Available < McpFraming::LengthPrefixSize + (int32)Length)
+		{
+			return EMcpFrameResult::Incomplete;
+		}
+
+		OutFrame = TArrayView<const uint8>(Start + McpFraming::LengthPrefixSize, (int32)Length);
+		OutConsumed = McpFraming::LengthPrefixSize + (int32)Length;
+		return EMcpFrameResult::Complete;
+	}
+
+	for (int32 Index = ScanOffset; Index < Available; ++Index)
+	{
+		if (Start[Index] == '\n')
+		{
+			OutFrame = TArrayView<const uint8>(Start, Index);
+			OutConsumed = Index + 1;
+			return EMcpFrameResult::Complete;
+		}
+	}
+
+	ScanOffset = Available;
+	return Available > MaxFrameSize ? EMcpFrameResult::TooLarge : EMcpFrameResult::Incomplete;
+}
+
+void FMcpReceiveBuffer::Consume(int32 NumBytes)
+{
+	Head += NumBytes;
+	ScanOffset = 0;
+
+	if (Head == Tail)
+	{
+		Head = 0;
+		Tail = 0;
+	}
+	else if (Head > Data.Num() / 2)
+	{
+		Compact();
+	}
+}
+
+void FMcpReceiveBuffer::Compact()
+{
+	if (Head == 0)
+	{
+		return;
+	}
+
+	const int32 Remaining = Num();
+	if (Remaining > 0)
+	{
+		FMemory::Memmove(Data.GetData(), Data.GetData() + Head, Remaining);
+	}
+	Head = 0;
+	Tail = Remaining;
+}
@@ -0,0 +1,88 @@
+#include "UnrealEngineMCPIdempotency.h"
+#include "HAL/PlatformTime.h"
+
+#define MCP_IDEMPOTENCY_MAX_ENTRIES 256
+#define MCP_IDEMPOTENCY_TTL_SECONDS 600.0           // Longer than any client retry loop
+#define MCP_IDEMPOTENCY_MAX_BODY_BYTES (1024 * 1024)  // Mutations answer small; big reads are cheap to redo
+
+FMcpIdempotencyCache::FMcpIdempotencyCache()
+	: Replays(0)
+{
+}
+
+bool FMcpIdempotencyCache::Find(const FString& Key, FMcpResponseBody& OutBody, EMcpEncoding& OutEncoding)
+{
+	FScopeLock Lock(&EntriesLock);
+	EvictExpired(FPlatformTime::Seconds());
+
+	const FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	// Copied: the same key may be retried more than once
+	OutBody = Entry->Body;
+	OutEncoding = Entry->Encoding;
+	Replays++;
+	return true;
+}
+
+void FMcpIdempotencyCache::Store(const FString& Key, const FMcpResponseBody& Body, EMcpEncoding Encoding)
+{
+	if (Body.Num() > MCP_IDEMPOTENCY_MAX_BODY_BYTES)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FMcpIdempotencyCache: Response for key %s too large to keep (%lld bytes)"), *Key, Body.Num());
+		return;
+	}
+
+	FScopeLock Lock(&EntriesLock);
+	const double Now = FPlatformTime::Seconds();
+	EvictExpired(Now);
+
+	if (!Entries.Contains(Key))
+	{
+		while (InsertionOrder.Num() >= MCP_IDEMPOTENCY_MAX_ENTRIES)
+		{
+			Entries.Remove(InsertionOrder[0]);
+			InsertionOrder.RemoveAt(0);
+		}
+		InsertionOrder.Add(Key);
+	}
+
+	Entries.Add(Key, FEntry{ Body, Encoding, Now });
+}
+
+void FMcpIdempotencyCache::Reset()
+{
+	FScopeLock Lock(&EntriesLock);
+	Entries.Empty();
+	InsertionOrder.Empty();
+}
+
+int32 FMcpIdempotencyCache::Num() const
+{
+	FScopeLock Lock(&EntriesLock);
+	return Entries.Num();
+}
+
+void FMcpIdempotencyCache::EvictExpired(double Now)
+{
+	// Insertion order is also age order
+	int32 ExpiredCount = 0;
+	while (ExpiredCount < InsertionOrder.Num())
+	{
+		const FEntry* Entry = Entries.Find(InsertionOrder[ExpiredCount]);
+		if (Entry && Now - Entry->StoredAt <= MCP_IDEMPOTENCY_TTL_SECONDS)
+		{
+			break;
+		}
+		Entries.Remove(InsertionOrder[ExpiredCount]);
+		ExpiredCount++;
+	}
+
+	if (ExpiredCount > 0)
+	{
+		InsertionOrder.RemoveAt(0, ExpiredCount);
+	}
+}
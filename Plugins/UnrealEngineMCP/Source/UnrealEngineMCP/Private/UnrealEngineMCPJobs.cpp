@@ -0,0 +1,220 @@
+#include "UnrealEngineMCPJobs.h"
+#include "HAL/PlatformTime.h"
+
+#define MCP_MAX_UNFINISHED_JOBS 16
+#define MCP_JOB_RETENTION_SECONDS 600.0  // Finished jobs can be queried this long
+
+const TCHAR* McpJobs::ToString(EMcpJobState State)
+{
+	switch (State)
+	{
+	case EMcpJobState::Running:
+		return TEXT("running");
+	case EMcpJobState::Succeeded:
+		return TEXT("succeeded");
+	case EMcpJobState::Failed:
+		return TEXT("failed");
+	case EMcpJobState::Cancelled:
+		return TEXT("cancelled");
+	case EMcpJobState::Queued:
+	default:
+		return TEXT("queued");
+	}
+}
+
+FMcpJobManager::FMcpJobManager()
+	: NextJobId(1)
+{
+}
+
+FString FMcpJobManager::Submit(const FString& CommandType, FMcpJobSliceFunction&& Work, FString& OutError)
+{
+	FScopeLock Lock(&JobsLock);
+
+	PruneFinished(FPlatformTime::Seconds());
+
+	int32 Unfinished = 0;
+	for (const TSharedPtr<FJob>& Job : Jobs)
+	{
+		Unfinished += Job->IsFinished() ? 0 : 1;
+	}
+	if (Unfinished >= MCP_MAX_UNFINISHED_JOBS)
+	{
+		OutError = FString::Printf(TEXT("Too many unfinished jobs (%d)"), Unfinished);
+		return FString();
+	}
+
+	TSharedPtr<FJob> Job = MakeShared<FJob>();
+	Job->Id = FString::Printf(TEXT("job-%u"), NextJobId++);
+	Job->CommandType = CommandType;
+	Job->Work = MoveTemp(Work);
+	Job->SubmittedAt = FPlatformTime::Seconds();
+	Jobs.Add(Job);
+
+	UE_LOG(LogTemp, Display, TEXT("FMcpJobManager: Submitted %s (%s)"), *Job->Id, *CommandType);
+	return Job->Id;
+}
+
+TSharedPtr<FJsonObject> FMcpJobManager::GetStatus(const FString& JobId) const
+{
+	FScopeLock Lock(&JobsLock);
+	for (const TSharedPtr<FJob>& Job : Jobs)
+	{
+		if (Job->Id == JobId)
+		{
+			TSharedPtr<FJsonObject> StatusObj = ToJson(*Job, true);
+			StatusObj->SetBoolField(TEXT("success"), true);
+			return StatusObj;
+		}
+	}
+	return nullptr;
+}
+
+TSharedPtr<FJsonObject> FMcpJobManager::ListJobs() const
+{
+	TArray<TSharedPtr<FJsonValue>> JobsArray;
+	{
+		FScopeLock Lock(&JobsLock);
+		for (const TSharedPtr<FJob>& Job : Jobs)
+		{
+			JobsArray.Add(MakeShared<FJsonValueObject>(ToJson(*Job, false)));
+		}
+	}
+
+	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+	ResultObj->SetArrayField(TEXT("jobs"), JobsArray);
+	ResultObj->SetNumberField(TEXT("count"), JobsArray.Num());
+	ResultObj->SetBoolField(TEXT("success"), true);
+	return ResultObj;
+}
+
+bool FMcpJobManager::Cancel(const FString& JobId)
+{
+	FScopeLock Lock(&JobsLock);
+	for (const TSharedPtr<FJob>& Job : Jobs)
+	{
+		if (Job->Id == JobId && !Job->IsFinished())
+		{
+			// Queued jobs never start; a running one stops before its next slice
+			Job->Cancellation.Cancel();
+			return true;
+		}
+	}
+	return false;
+}
+
+void FMcpJobManager::Tick(double EndTime)
+{
+	bool bRanSlice = false;
+
+	while (!bRanSlice || FPlatformTime::Seconds() < EndTime)
+	{
+		TSharedPtr<FJob> Job;
+		{
+			FScopeLock Lock(&JobsLock);
+			for (const TSharedPtr<FJob>& Candidate : Jobs)
+			{
+				if (Candidate->IsFinished())
+				{
+					continue;
+				}
+
+				if (Candidate->Cancellation.IsCancelled())
+				{
+					Finish(*Candidate, EMcpJobState::Cancelled);
+					continue;
+				}
+
+				Job = Candidate;
+				if (Job->State == EMcpJobState::Queued)
+				{
+					Job->State = EMcpJobState::Running;
+					Job->StartedAt = FPlatformTime::Seconds();
+				}
+				break;
+			}
+		}
+
+		if (!Job.IsValid())
+		{
+			break;
+		}
+
+		// Outside the lock so job_status keeps answering while the slice runs
+		float Progress = Job->Progress;
+		TSharedPtr<FJsonObject> Result = Job->Work(Progress);
+		bRanSlice = true;
+
+		FScopeLock Lock(&JobsLock);
+		Job->Progress = FMath::Clamp(Progress, 0.0f, 1.0f);
+		if (Result.IsValid())
+		{
+			bool bSuccess = true;
+			Result->TryGetBoolField(TEXT("success"), bSuccess);
+			Job->Result = Result;
+			if (!bSuccess)
+			{
+				Result->TryGetStringField(TEXT("error"), Job->Error);
+			}
+			Finish(*Job, bSuccess ? EMcpJobState::Succeeded : EMcpJobState::Failed);
+		}
+	}
+
+	FScopeLock Lock(&JobsLock);
+	PruneFinished(FPlatformTime::Seconds());
+}
+
+void FMcpJobManager::Reset()
+{
+	FScopeLock Lock(&JobsLock);
+	Jobs.Empty();
+}
+
+TSharedPtr<FJsonObject> FMcpJobManager::ToJson(const FJob& Job, bool bIncludeResult) const
+{
+	const double Now = FPlatformTime::Seconds();
+
+	TSharedPtr<FJsonObject> JobObj = MakeShared<FJsonObject>();
+	JobObj->SetStringField(TEXT("job_id"), Job.Id);
+	JobObj->SetStringField(TEXT("type"), Job.CommandType);
+	JobObj->SetStringField(TEXT("state"), McpJobs::ToString(Job.State));
+	JobObj->SetNumberField(TEXT("progress"), Job.Progress);
+	JobObj->SetNumberField(TEXT("queued_ms"), ((Job.StartedAt > 0.0 ? Job.StartedAt : (Job.IsFinished() ? Job.FinishedAt : Now)) - Job.SubmittedAt) * 1000.0);
+	if (Job.StartedAt > 0.0)
+	{
+		JobObj->SetNumberField(TEXT("running_ms"), ((Job.IsFinished() ? Job.FinishedAt : Now) - Job.StartedAt) * 1000.0);
+	}
+
+	if (!Job.Error.IsEmpty())
+	{
+		JobObj->SetStringField(TEXT("error"), Job.Error);
+	}
+	if (bIncludeResult && Job.Result.IsValid())
+	{
+		// Results are never modified once stored, so sharing them across threads is safe
+		JobObj->SetObjectField(TEXT("result"), Job.Result);
+	}
+	return JobObj;
+}
+
+void FMcpJobManager::Finish(FJob& Job, EMcpJobState State)
+{
+	Job.State = State;
+	Job.FinishedAt = FPlatformTime::Seconds();
+	if (State == EMcpJobState::Succeeded)
+	{
+		Job.Progress = 1.0f;
+	}
+	// Releases whatever the work captured
+	Job.Work = nullptr;
+
+	UE_LOG(LogTemp, Display, TEXT("FMcpJobManager: %s (%s) %s"), *Job.Id, *Job.CommandType, McpJobs::ToString(State));
+}
+
+void FMcpJobManager::PruneFinished(double Now)
+{
+	Jobs.RemoveAll([Now](const TSharedPtr<FJob>& Job)
+	{
+		return Job->IsFinished() && Now - Job->FinishedAt > MCP_JOB_RETENTION_SECONDS;
+	});
+}
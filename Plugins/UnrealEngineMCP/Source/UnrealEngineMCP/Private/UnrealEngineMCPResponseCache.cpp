@@ -0,0 +1,503 @@
+#include "UnrealEngineMCPResponseCache.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "GameplayTagsModule.h"
+#include "Misc/CoreDelegates.h"
+#include "Dom/JsonValue.h"
+
+#define MCP_RESPONSE_CACHE_MAX_ENTRIES 256
+#define MCP_RESPONSE_CACHE_MAX_BYTES (64 * 1024 * 1024)
+#define MCP_RESPONSE_CACHE_MAX_BODY_BYTES (8 * 1024 * 1024)
+
+namespace
+{
+	// Epochs a cached command reads
+	enum EReads : uint8
+	{
+		ReadsBlueprint = 1 << 0,         // The blueprint named by "blueprint_name"
+		ReadsBlueprintClasses = 1 << 1,  // Any generated class, since class lookups may resolve to one
+		ReadsAssets = 1 << 2,
+		ReadsActors = 1 << 3,
+		ReadsReflection = 1 << 4,
+		ReadsTags = 1 << 5
+	};
+
+	uint8 GetReads(const FString& CommandType)
+	{
+		static const TMap<FString, uint8> CachedCommands = {
+			{ TEXT("analyze_blueprint"), ReadsBlueprint | ReadsReflection },
+			{ TEXT("list_graphs"), ReadsBlueprint },
+			{ TEXT("list_blueprint_nodes"), ReadsBlueprint | ReadsReflection },
+			{ TEXT("get_blueprint_variables"), ReadsBlueprint },
+			{ TEXT("get_class_functions"), ReadsReflection | ReadsBlueprintClasses },
+			{ TEXT("get_class_properties"), ReadsReflection | ReadsBlueprintClasses },
+			{ TEXT("search_assets"), ReadsAssets | ReadsBlueprintClasses | ReadsReflection },  // Class scope and base_class resolve classes
+			{ TEXT("list_folder_assets"), ReadsAssets },
+			{ TEXT("list_gameplay_tags"), ReadsTags },
+			{ TEXT("list_level_actors"), ReadsActors },
+			{ TEXT("search_actors"), ReadsActors },
+		};
+
+		const uint8* Reads = CachedCommands.Find(CommandType);
+		return Reads ? *Reads : 0;
+	}
+
+	void AppendCanonicalObject(FString& Out, const TSharedPtr<FJsonObject>& Object, bool bTopLevel);
+
+	void AppendCanonicalValue(FString& Out, const TSharedPtr<FJsonValue>& Value)
+	{
+		switch (Value.IsValid() ? Value->Type : EJson::Null)
+		{
+		case EJson::String:
+			Out += TEXT("\"");
+			Out += Value->AsString().ReplaceCharWithEscapedChar();
+			Out += TEXT("\"");
+			break;
+		case EJson::Number:
+			Out += FString::Printf(TEXT("%.17g"), Value->AsNumber());
+			break;
+		case EJson::Boolean:
+			Out += Value->AsBool() ? TEXT("true") : TEXT("false");
+			break;
+		case EJson::Array:
+		{
+			Out += TEXT("[");
+			const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+			for (int32 Index = 0; Index < Items.Num(); ++Index)
+			{
+				if (Index > 0)
+				{
+					Out += TEXT(",");
+				}
+				AppendCanonicalValue(Out, Items[Index]);
+			}
+			Out += TEXT("]");
+			break;
+		}
+		case EJson::Object:
+			AppendCanonicalObject(Out, Value->AsObject(), false);
+			break;
+		default:
+			Out += TEXT("null");
+			break;
+		}
+	}
+
+	// Keys sorted, so clients that build params in a different order share entries
+	void AppendCanonicalObject(FString& Out, const TSharedPtr<FJsonObject>& Object, bool bTopLevel)
+	{
+		Out += TEXT("{");
+		if (Object.IsValid())
+		{
+			TArray<FString> Keys;
+			Object->Values.GetKeys(Keys);
+			Keys.Sort([](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+
+			bool bFirst = true;
+			for (const FString& Key : Keys)
+			{
+				if (bTopLevel && Key == TEXT("bypass_cache"))
+				{
+					continue;
+				}
+				if (!bFirst)
+				{
+					Out += TEXT(",");
+				}
+				bFirst = false;
+
+				Out += TEXT("\"");
+				Out += Key.ReplaceCharWithEscapedChar();
+				Out += TEXT("\":");
+				AppendCanonicalValue(Out, Object->Values[Key]);
+			}
+		}
+		Out += TEXT("}");
+	}
+}
+
+FMcpResponseCache::FMcpResponseCache()
+	: bEnabled(true)
+	, BlueprintClassesEpoch(0)
+	, AssetsEpoch(0)
+	, ActorsEpoch(0)
+	, ReflectionEpoch(0)
+	, TagsEpoch(0)
+	, NextBlueprintEpoch(0)
+	, BlueprintEpochFloor(0)
+	, TotalBytes(0)
+	, Hits(0)
+	, Misses(0)
+	, Stale(0)
+	, Bypassed(0)
+	, bStarted(false)
+{
+}
+
+FMcpResponseCache::~FMcpResponseCache()
+{
+	Stop();
+}
+
+void FMcpResponseCache::Start()
+{
+	check(IsInGameThread());
+	if (bStarted || !GEngine)
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMcpResponseCache::HandleAssetChanged);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMcpResponseCache::HandleAssetChanged);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMcpResponseCache::HandleAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FMcpResponseCache::HandleAssetChanged);
+
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMcpResponseCache::HandleActorChanged);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMcpResponseCache::HandleActorChanged);
+	ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMcpResponseCache::HandleActorChanged);
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FMcpResponseCache::HandleActorChanged);
+	MapChangeHandle = FEditorDelegates::MapChange.AddRaw(this, &FMcpResponseCache::HandleMapChange);
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FMcpResponseCache::HandleUndoRedo);
+
+	// Editor edits Modify() what they touch, including blueprint graphs that are not recompiled yet
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FMcpResponseCache::HandleObjectModified);
+	if (GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FMcpResponseCache::HandleBlueprintPreCompile);
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMcpResponseCache::HandleBlueprintCompiled);
+	}
+
+	// Hot reload and live coding
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FMcpResponseCache::HandleReloadComplete);
+	TagTreeChangedHandle = IGameplayTagsModule::OnGameplayTagTreeChanged.AddRaw(this, &FMcpResponseCache::HandleTagTreeChanged);
+
+	// Nothing was watching while stopped, so entries a late worker stored then must not hit
+	BumpAll();
+	bStarted = true;
+}
+
+void FMcpResponseCache::Stop()
+{
+	if (!bStarted)
+	{
+		return;
+	}
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+
+	// The engine may already be tearing down on editor exit
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FEditorDelegates::MapChange.Remove(MapChangeHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	IGameplayTagsModule::OnGameplayTagTreeChanged.Remove(TagTreeChangedHandle);
+
+	// Nothing bumps the epochs any more, so nothing stored can be trusted
+	Reset();
+	bStarted = false;
+}
+
+bool FMcpResponseCache::IsCachedCommand(const FString& CommandType)
+{
+	return GetReads(CommandType) != 0;
+}
+
+bool FMcpResponseCache::Find(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, EMcpEncoding Encoding, bool bStreamed,
+	FMcpResponseBody& OutBody, FTicket& OutTicket)
+{
+	OutTicket = FTicket();
+	if (!bEnabled || !IsCachedCommand(CommandType))
+	{
+		return false;
+	}
+
+	// Streamed responses arrive as partial frames, so the final body is not the whole answer
+	bool bBypass = false;
+	if (bStreamed || (Params->TryGetBoolField(TEXT("bypass_cache"), bBypass) && bBypass))
+	{
+		Bypassed++;
+		return false;
+	}
+
+	FString Key = FString::Printf(TEXT("%s:%s:"), McpEncoding::ToString(Encoding), *CommandType);
+	AppendCanonicalObject(Key, Params, true);
+	const FStamp Stamp = MakeStamp(CommandType, Params);
+
+	{
+		FScopeLock Lock(&EntriesLock);
+		if (const FEntry* Entry = Entries.Find(Key))
+		{
+			if (Entry->Stamp == Stamp)
+			{
+				// Copied: the entry keeps serving later requests
+				OutBody = Entry->Body;
+				Hits++;
+				return true;
+			}
+			Stale++;
+		}
+	}
+
+	Misses++;
+	OutTicket.Key = MoveTemp(Key);
+	OutTicket.Stamp = Stamp;
+	return false;
+}
+
+void FMcpResponseCache::Store(const FTicket& Ticket, const FMcpResponseBody& Body)
+{
+	if (!Ticket.IsValid())
+	{
+		return;
+	}
+
+	if (Body.Num() > MCP_RESPONSE_CACHE_MAX_BODY_BYTES)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("FMcpResponseCache: Response too large to cache (%lld bytes)"), Body.Num());
+		return;
+	}
+
+	FScopeLock Lock(&EntriesLock);
+	if (FEntry* Existing = Entries.Find(Ticket.Key))
+	{
+		// Two workers that missed together both store; either body is right for its stamp
+		TotalBytes -= Existing->Body.Num();
+		Existing->Body = Body;
+		Existing->Stamp = Ticket.Stamp;
+		TotalBytes += Body.Num();
+		return;
+	}
+
+	while (InsertionOrder.Num() > 0
+		&& (InsertionOrder.Num() >= MCP_RESPONSE_CACHE_MAX_ENTRIES || TotalBytes + Body.Num() > MCP_RESPONSE_CACHE_MAX_BYTES))
+	{
+		RemoveOldest();
+	}
+
+	Entries.Add(Ticket.Key, FEntry{ Body, Ticket.Stamp });
+	InsertionOrder.Add(Ticket.Key);
+	TotalBytes += Body.Num();
+}
+
+void FMcpResponseCache::NoteCommandExecuted(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+	// Arbitrary scripts and batches of commands can change anything
+	if (CommandType == TEXT("execute_python") || CommandType == TEXT("batch"))
+	{
+		BumpAll();
+		return;
+	}
+
+	// Handlers set actor properties without Modify() and edit graphs without recompiling
+	ActorsEpoch++;
+	FString BlueprintName;
+	if (Params.IsValid() && Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
+	{
+		BumpBlueprint(BlueprintName);
+	}
+}
+
+void FMcpResponseCache::Reset()
+{
+	FScopeLock Lock(&EntriesLock);
+	Entries.Empty();
+	InsertionOrder.Empty();
+	TotalBytes = 0;
+}
+
+TSharedPtr<FJsonObject> FMcpResponseCache::GetStatsJson() const
+{
+	TSharedPtr<FJsonObject> StatsObj = MakeShared<FJsonObject>();
+	StatsObj->SetBoolField(TEXT("enabled"), bEnabled);
+	{
+		FScopeLock Lock(&EntriesLock);
+		StatsObj->SetNumberField(TEXT("entries"), Entries.Num());
+		StatsObj->SetNumberField(TEXT("bytes"), TotalBytes);
+	}
+	StatsObj->SetNumberField(TEXT("hits"), Hits.Load());
+	StatsObj->SetNumberField(TEXT("misses"), Misses.Load());
+	StatsObj->SetNumberField(TEXT("stale"), Stale.Load());
+	StatsObj->SetNumberField(TEXT("bypassed"), Bypassed.Load());
+
+	TSharedPtr<FJsonObject> EpochsObj = MakeShared<FJsonObject>();
+	EpochsObj->SetNumberField(TEXT("blueprint_classes"), BlueprintClassesEpoch.Load());
+	EpochsObj->SetNumberField(TEXT("assets"), AssetsEpoch.Load());
+	EpochsObj->SetNumberField(TEXT("actors"), ActorsEpoch.Load());
+	EpochsObj->SetNumberField(TEXT("reflection"), ReflectionEpoch.Load());
+	EpochsObj->SetNumberField(TEXT("tags"), TagsEpoch.Load());
+	StatsObj->SetObjectField(TEXT("epochs"), EpochsObj);
+	return StatsObj;
+}
+
+FMcpResponseCache::FStamp FMcpResponseCache::MakeStamp(const FString& CommandType, const TSharedPtr<FJsonObject>& Params) const
+{
+	const uint8 Reads = GetReads(CommandType);
+
+	FStamp Stamp;
+	if (Reads & ReadsBlueprint)
+	{
+		FString BlueprintName;
+		Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName);
+		Stamp.Blueprint = GetBlueprintEpoch(BlueprintName);
+	}
+	if (Reads & ReadsBlueprintClasses)
+	{
+		Stamp.BlueprintClasses = BlueprintClassesEpoch.Load();
+	}
+	if (Reads & ReadsAssets)
+	{
+		Stamp.Assets = AssetsEpoch.Load();
+	}
+	if (Reads & ReadsActors)
+	{
+		Stamp.Actors = ActorsEpoch.Load();
+	}
+	if (Reads & ReadsReflection)
+	{
+		Stamp.Reflection = ReflectionEpoch.Load();
+	}
+	if (Reads & ReadsTags)
+	{
+		Stamp.Tags = TagsEpoch.Load();
+	}
+	return Stamp;
+}
+
+uint32 FMcpResponseCache::GetBlueprintEpoch(const FString& BlueprintName) const
+{
+	// Keyed by object name: blueprints with the same name in different folders share a counter,
+	// which only costs a few extra misses
+	FScopeLock Lock(&BlueprintEpochsLock);
+	const uint32* Epoch = BlueprintEpochs.Find(FName(*BlueprintName));
+	return FMath::Max(Epoch ? *Epoch : 0u, BlueprintEpochFloor);
+}
+
+void FMcpResponseCache::BumpBlueprint(const FString& BlueprintName)
+{
+	FScopeLock Lock(&BlueprintEpochsLock);
+	BlueprintEpochs.Add(FName(*BlueprintName), ++NextBlueprintEpoch);
+}
+
+void FMcpResponseCache::BumpAll()
+{
+	{
+		FScopeLock Lock(&BlueprintEpochsLock);
+		BlueprintEpochFloor = ++NextBlueprintEpoch;
+	}
+	BlueprintClassesEpoch++;
+	AssetsEpoch++;
+	ActorsEpoch++;
+	ReflectionEpoch++;
+	TagsEpoch++;
+}
+
+void FMcpResponseCache::RemoveOldest()
+{
+	const FEntry* Oldest = Entries.Find(InsertionOrder[0]);
+	if (Oldest)
+	{
+		TotalBytes -= Oldest->Body.Num();
+		Entries.Remove(InsertionOrder[0]);
+	}
+	InsertionOrder.RemoveAt(0);
+}
+
+void FMcpResponseCache::HandleAssetChanged(const FAssetData& AssetData)
+{
+	AssetsEpoch++;
+}
+
+void FMcpResponseCache::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	AssetsEpoch++;
+}
+
+void FMcpResponseCache::HandleActorChanged(AActor* Actor)
+{
+	ActorsEpoch++;
+}
+
+void FMcpResponseCache::HandleMapChange(uint32 MapChangeFlags)
+{
+	ActorsEpoch++;
+}
+
+void FMcpResponseCache::HandleObjectModified(UObject* Object)
+{
+	if (!Object)
+	{
+		return;
+	}
+
+	UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+	if (!Blueprint)
+	{
+		Blueprint = Object->GetTypedOuter<UBlueprint>();
+	}
+	if (Blueprint)
+	{
+		BumpBlueprint(Blueprint->GetName());
+	}
+	else if (Object->IsA<AActor>() || Object->GetTypedOuter<AActor>())
+	{
+		ActorsEpoch++;
+	}
+}
+
+void FMcpResponseCache::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		BumpBlueprint(Blueprint->GetName());
+	}
+	BlueprintClassesEpoch++;
+}
+
+void FMcpResponseCache::HandleBlueprintCompiled()
+{
+	// Reinstancing replaces the old class's actors in the level
+	BlueprintClassesEpoch++;
+	ActorsEpoch++;
+}
+
+void FMcpResponseCache::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+	ReflectionEpoch++;
+	BlueprintClassesEpoch++;
+}
+
+void FMcpResponseCache::HandleTagTreeChanged()
+{
+	TagsEpoch++;
+}
+
+void FMcpResponseCache::HandleUndoRedo()
+{
+	// A transaction can span any number of objects
+	BumpAll();
+}
@@ -0,0 +1,358 @@
+#include "UnrealEngineMCPResponseWriter.h"
+#include "UnrealEngineMCPBridge.h"
+#include "HAL/PlatformTime.h"
+
+// A partial frame is flushed once it holds this much data or has been open this long
+#define MCP_STREAM_CHUNK_BYTES FMcpResponseBody::ChunkSize
+#define MCP_STREAM_FLUSH_INTERVAL 0.1
+
+FMcpResponseBody FMcpResponseBody::FromString(const FString& Json)
+{
+	FMcpResponseBody Result;
+	FTCHARToUTF8 UTF8Json(*Json);
+	Result.Append((const uint8*)UTF8Json.Get(), UTF8Json.Length());
+	return Result;
+}
+
+void FMcpResponseBody::Append(const uint8* Data, int64 Count)
+{
+	while (Count > 0)
+	{
+		if (Chunks.Num() == 0 || Chunks.Last().Num() == ChunkSize)
+		{
+			Chunks.AddDefaulted_GetRef().Reserve(ChunkSize);
+		}
+
+		TArray<uint8>& Chunk = Chunks.Last();
+		const int32 Copy = (int32)FMath::Min<int64>(Count, ChunkSize - Chunk.Num());
+		Chunk.Append(Data, Copy);
+
+		Data += Copy;
+		Count -= Copy;
+		Size += Copy;
+	}
+}
+
+void FMcpResponseBody::Reset()
+{
+	Chunks.Reset();
+	Size = 0;
+}
+
+FString FMcpResponseBody::Preview(int32 MaxBytes) const
+{
+	if (Chunks.Num() == 0)
+	{
+		return FString();
+	}
+
+	const TArray<uint8>& First = Chunks[0];
+	FUTF8ToTCHAR Converted((const ANSICHAR*)First.GetData(), FMath::Min(MaxBytes, First.Num()));
+	return FString(Converted.Length(), Converted.Get());
+}
+
+FMcpResponseStream::FMcpResponseStream(const TSharedPtr<FMcpCompletionSignal, ESPMode::ThreadSafe>& InSignal)
+	: Signal(InSignal)
+{
+}
+
+void FMcpResponseStream::PushChunk(FMcpResponseBody&& Chunk)
+{
+	{
+		FScopeLock Lock(&ChunkLock);
+		PendingChunks.Add(MoveTemp(Chunk));
+	}
+
+	if (Signal.IsValid())
+	{
+		Signal->Trigger();
+	}
+}
+
+bool FMcpResponseStream::PopChunks(TArray<FMcpResponseBody>& OutChunks)
+{
+	FScopeLock Lock(&ChunkLock);
+	if (PendingChunks.Num() == 0)
+	{
+		return false;
+	}
+
+	for (FMcpResponseBody& Chunk : PendingChunks)
+	{
+		OutChunks.Add(MoveTemp(Chunk));
+	}
+	PendingChunks.Reset();
+	return true;
+}
+
+TAtomic<int32> FMcpResponseSlot::Outstanding(0);
+TAtomic<int32> FMcpResponseSlot::Unclaimed(0);
+TAtomic<int32> FMcpResponseSlot::Expired(0);
+TAtomic<int32> FMcpResponseSlot::Discarded(0);
+
+FMcpResponseSlot::FMcpResponseSlot()
+	: State(EState::Pending)
+	, FulfilledAt(0.0)
+{
+	Outstanding++;
+}
+
+FMcpResponseSlot::~FMcpResponseSlot()
+{
+	// Last reference gone with the result never taken (the requester let go after it arrived)
+	if (State.Load() == EState::Ready)
+	{
+		Unclaimed--;
+	}
+	Outstanding--;
+}
+
+void FMcpResponseSlot::Fulfil(FMcpResponseBody&& InBody)
+{
+	check(State.Load() == EState::Pending);
+	Body = MoveTemp(InBody);
+	FulfilledAt = FPlatformTime::Seconds();
+	Unclaimed++;
+
+	// Publishes Body and FulfilledAt to the consumer
+	State.Store(EState::Ready);
+}
+
+void FMcpResponseSlot::Discard()
+{
+	check(State.Load() == EState::Pending);
+	Discarded++;
+	State.Store(EState::Discarded);
+}
+
+bool FMcpResponseSlot::Take(FMcpResponseBody& OutBody)
+{
+	EState Expected = EState::Ready;
+	if (!State.CompareExchange(Expected, EState::Taken))
+	{
+		return false;
+	}
+
+	OutBody = MoveTemp(Body);
+	Unclaimed--;
+	return true;
+}
+
+bool FMcpResponseSlot::ExpireIfOlderThan(double CutoffTime)
+{
+	EState Current = State.Load();
+	if (Current == EState::Pending)
+	{
+		return false;
+	}
+	if (Current != EState::Ready)
+	{
+		return true;
+	}
+	if (FulfilledAt >= CutoffTime)
+	{
+		return false;
+	}
+
+	// Loses to a concurrent Take, in which case the consumer got the body
+	if (State.CompareExchange(Current, EState::Expired))
+	{
+		// Reset() would keep the chunk allocations
+		Body = FMcpResponseBody();
+		Unclaimed--;
+		Expired++;
+	}
+	return true;
+}
+
+FMcpResponseWriter::FMcpResponseWriter(const FMcpResponseStreamPtr& InStream, EMcpEncoding InEncoding, const FMcpCancellationTokenPtr& InCancellation)
+	: Archive(Body)
+	, Encoding(InEncoding)
+	, Writer(MakeUnique<FMcpValueWriter>(Archive, InEncoding))
+	, Stream(InStream)
+	, Cancellation(InCancellation)
+	, bCancellationObserved(false)
+	, bHasError(false)
+	, SerializeSeconds(0.0)
+{
+}
+
+bool FMcpResponseWriter::IsCancelled() const
+{
+	const bool bCancelled = Cancellation.IsValid() && Cancellation->IsCancelled();
+	bCancellationObserved |= bCancelled;
+	return bCancelled;
+}
+
+void FMcpResponseWriter::ResetWriter()
+{
+	Body.Reset();
+	Writer = MakeUnique<FMcpValueWriter>(Archive, Encoding);
+	bHasError = false;
+}
+
+void FMcpResponseWriter::BeginSuccess()
+{
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("status"), TEXT("success"));
+	Writer->WriteObjectStart(TEXT("result"));
+}
+
+void FMcpResponseWriter::EndSuccess()
+{
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+}
+
+void FMcpResponseWriter::WriteError(const FString& Message)
+{
+	ResetWriter();
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("status"), TEXT("error"));
+	Writer->WriteValue(TEXT("error"), Message);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	bHasError = true;
+}
+
+void FMcpResponseWriter::WriteResponse(const TSharedPtr<FJsonObject>& ResponseJson)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	ResetWriter();
+	Writer->WriteJsonValue(FString(), MakeShared<FJsonValueObject>(ResponseJson));
+	Writer->Close();
+	SerializeSeconds += FPlatformTime::Seconds() - StartTime;
+	FString Status;
+	bHasError = ResponseJson->TryGetStringField(TEXT("status"), Status) && Status == TEXT("error");
+}
+
+void FMcpResponseWriter::ReplaceBody(FMcpResponseBody&& InBody)
+{
+	ResetWriter();
+	Body = MoveTemp(InBody);
+}
+
+void FMcpResponseWriter::WriteField(const FString& Name, const TSharedPtr<FJsonValue>& Value)
+{
+	Writer->WriteJsonValue(Name, Value);
+}
+
+FMcpItemWriter::FMcpItemWriter(FMcpResponseWriter& InResponseWriter, const FString& InField)
+	: ResponseWriter(InResponseWriter)
+	, Field(InField)
+	, Stream(InResponseWriter.GetStream())
+	, ChunkItemCount(0)
+	, ChunkCount(0)
+	, LastFlushTime(FPlatformTime::Seconds())
+	, ItemCount(0)
+{
+	if (Stream.IsValid())
+	{
+		BeginChunk();
+	}
+	else
+	{
+		ResponseWriter.Values().WriteArrayStart(Field);
+	}
+}
+
+FMcpValueWriter& FMcpItemWriter::BeginItem()
+{
+	FMcpValueWriter& Values = Stream.IsValid() ? ChunkWriter->Values() : ResponseWriter.Values();
+	Values.WriteObjectStart();
+	return Values;
+}
+
+void FMcpItemWriter::EndItem()
+{
+	if (!Stream.IsValid())
+	{
+		ResponseWriter.Values().WriteObjectEnd();
+		ItemCount++;
+		return;
+	}
+
+	ChunkWriter->Values().WriteObjectEnd();
+	ItemCount++;
+	ChunkItemCount++;
+	FlushChunkIfDue();
+}
+
+void FMcpItemWriter::AddItem(const TSharedPtr<FJsonObject>& Item)
+{
+	FMcpValueWriter& Values = Stream.IsValid() ? ChunkWriter->Values() : ResponseWriter.Values();
+	Values.WriteJsonValue(FString(), MakeShared<FJsonValueObject>(Item));
+	ItemCount++;
+
+	if (Stream.IsValid())
+	{
+		ChunkItemCount++;
+		FlushChunkIfDue();
+	}
+}
+
+void FMcpItemWriter::Finish()
+{
+	FMcpValueWriter& Values = ResponseWriter.Values();
+
+	if (!Stream.IsValid())
+	{
+		Values.WriteArrayEnd();
+		return;
+	}
+
+	if (ChunkItemCount > 0)
+	{
+		FlushChunk();
+	}
+	ChunkWriter.Reset();
+
+	Values.WriteObjectStart(TEXT("stream"));
+	Values.WriteValue(TEXT("field"), Field);
+	Values.WriteValue(TEXT("items"), ItemCount);
+	Values.WriteValue(TEXT("chunks"), ChunkCount);
+	Values.WriteValue(TEXT("cancelled"), IsCancelled());
+	Values.WriteObjectEnd();
+}
+
+bool FMcpItemWriter::IsCancelled() const
+{
+	return ResponseWriter.IsCancelled();
+}
+
+void FMcpItemWriter::BeginChunk()
+{
+	ChunkWriter = MakeUnique<FMcpResponseWriter>(nullptr, ResponseWriter.GetEncoding());
+	ChunkItemCount = 0;
+
+	FMcpValueWriter& Values = ChunkWriter->Values();
+	Values.WriteObjectStart();
+	Values.WriteValue(TEXT("status"), TEXT("partial"));
+	Values.WriteValue(TEXT("field"), Field);
+	Values.WriteValue(TEXT("seq"), ChunkCount);
+	Values.WriteArrayStart(TEXT("items"));
+}
+
+void FMcpItemWriter::FlushChunkIfDue()
+{
+	// Serialized output is already in the chunk body, so its size is known as it grows
+	if (ChunkWriter->BodySize() >= MCP_STREAM_CHUNK_BYTES || FPlatformTime::Seconds() - LastFlushTime >= MCP_STREAM_FLUSH_INTERVAL)
+	{
+		FlushChunk();
+		BeginChunk();
+	}
+}
+
+void FMcpItemWriter::FlushChunk()
+{
+	FMcpValueWriter& Values = ChunkWriter->Values();
+	Values.WriteArrayEnd();
+	Values.WriteObjectEnd();
+	Values.Close();
+
+	Stream->PushChunk(ChunkWriter->MoveBody());
+	ChunkCount++;
+	LastFlushTime = FPlatformTime::Seconds();
+}
@@ -0,0 +1,145 @@
+#include "UnrealEngineMCPScheduler.h"
+#include "UnrealEngineMCPBridge.h"
+
+#define MCP_LANE_STARVATION_SECONDS 0.5  // Lower-priority requests waiting this long are served next
+
+const TCHAR* McpScheduling::ToString(EMcpPriority Priority)
+{
+	switch (Priority)
+	{
+	case EMcpPriority::ReadOnly:
+		return TEXT("read_only");
+	case EMcpPriority::Bulk:
+		return TEXT("bulk");
+	case EMcpPriority::Interactive:
+	default:
+		return TEXT("interactive");
+	}
+}
+
+int32 FMcpCommandScheduler::GetLaneIndex(const FMcpCommandRequest& Request)
+{
+	// Unknown commands only produce an error, which is cheap
+	return (int32)(Request.Command ? Request.Command->CostClass : EMcpPriority::Interactive);
+}
+
+const FMcpCommandRequest& FMcpCommandScheduler::GetHead(uint32 ConnectionId) const
+{
+	return PerConnection.FindChecked(ConnectionId)[0];
+}
+
+int32 FMcpCommandScheduler::FindStartable(int32 LaneIndex, TFunctionRef<bool(const FMcpCommandRequest&)> CanStart) const
+{
+	const TArray<uint32>& ServiceOrder = Lanes[LaneIndex].ServiceOrder;
+	for (int32 Entry = 0; Entry < ServiceOrder.Num(); Entry++)
+	{
+		if (CanStart(GetHead(ServiceOrder[Entry])))
+		{
+			return Entry;
+		}
+	}
+	return INDEX_NONE;
+}
+
+FMcpCommandScheduler::FMcpCommandScheduler()
+	: NumQueued(0)
+	, SelectedLane(INDEX_NONE)
+	, SelectedEntry(INDEX_NONE)
+	, StarvationSeconds(MCP_LANE_STARVATION_SECONDS)
+{
+}
+
+FMcpCommandScheduler::~FMcpCommandScheduler()
+{
+}
+
+void FMcpCommandScheduler::Push(FMcpCommandRequest&& Request)
+{
+	const uint32 ConnectionId = Request.ConnectionId;
+	TArray<FMcpCommandRequest>& Queue = PerConnection.FindOrAdd(ConnectionId);
+	Queue.Add(MoveTemp(Request));
+	NumQueued++;
+
+	// Behind its own earlier requests, it is not eligible to run until it reaches the head
+	if (Queue.Num() == 1)
+	{
+		Lanes[GetLaneIndex(Queue[0])].ServiceOrder.Add(ConnectionId);
+	}
+}
+
+const FMcpCommandRequest* FMcpCommandScheduler::Peek(double Now, TFunctionRef<bool(const FMcpCommandRequest&)> CanStart)
+{
+	SelectedLane = INDEX_NONE;
+	SelectedEntry = INDEX_NONE;
+
+	int32 Startable[(int32)EMcpPriority::Count];
+	for (int32 Index = 0; Index < (int32)EMcpPriority::Count; Index++)
+	{
+		Startable[Index] = FindStartable(Index, CanStart);
+	}
+
+	// A lower lane that has waited too long is served before anything else
+	for (int32 Index = (int32)EMcpPriority::Count - 1; Index > 0; Index--)
+	{
+		if (Startable[Index] != INDEX_NONE)
+		{
+			const FMcpCommandRequest& Head = GetHead(Lanes[Index].ServiceOrder[Startable[Index]]);
+			if (Now - Head.Timestamp > StarvationSeconds)
+			{
+				SelectedLane = Index;
+				SelectedEntry = Startable[Index];
+				return &Head;
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < (int32)EMcpPriority::Count; Index++)
+	{
+		if (Startable[Index] != INDEX_NONE)
+		{
+			SelectedLane = Index;
+			SelectedEntry = Startable[Index];
+			return &GetHead(Lanes[Index].ServiceOrder[SelectedEntry]);
+		}
+	}
+
+	return nullptr;
+}
+
+void FMcpCommandScheduler::Pop(FMcpCommandRequest& OutRequest)
+{
+	check(SelectedLane != INDEX_NONE && Lanes[SelectedLane].ServiceOrder.IsValidIndex(SelectedEntry));
+	FLane& Lane = Lanes[SelectedLane];
+
+	const uint32 ConnectionId = Lane.ServiceOrder[SelectedEntry];
+	TArray<FMcpCommandRequest>& Queue = PerConnection.FindChecked(ConnectionId);
+	OutRequest = MoveTemp(Queue[0]);
+	Queue.RemoveAt(0);
+	NumQueued--;
+
+	// Rotate: the connection goes to the back of the lane of its next request, if it has one
+	Lane.ServiceOrder.RemoveAt(SelectedEntry);
+	if (Queue.Num() > 0)
+	{
+		Lanes[GetLaneIndex(Queue[0])].ServiceOrder.Add(ConnectionId);
+	}
+	else
+	{
+		PerConnection.Remove(ConnectionId);
+	}
+
+	SelectedLane = INDEX_NONE;
+	SelectedEntry = INDEX_NONE;
+}
+
+void FMcpCommandScheduler::Reset()
+{
+	PerConnection.Reset();
+	for (FLane& Lane : Lanes)
+	{
+		Lane.ServiceOrder.Reset();
+	}
+	NumQueued = 0;
+	SelectedLane = INDEX_NONE;
+	SelectedEntry = INDEX_NONE;
+}
@@ -0,0 +1,274 @@
+#include "UnrealEngineMCPStats.h"
+#include "UnrealEngineMCPCommandRegistry.h"
+#include "HAL/PlatformTime.h"
+#include "Math/UnrealMathUtility.h"
+
+#define MCP_HISTOGRAM_SUB_BUCKET_BITS 5   // 32 buckets per power of two
+#define MCP_HISTOGRAM_MAX_EXPONENT 36     // Larger values are clamped (2^36 us is about 19 hours)
+
+namespace
+{
+	constexpr int32 SubBucketCount = 1 << MCP_HISTOGRAM_SUB_BUCKET_BITS;
+	constexpr int32 BucketCount = SubBucketCount * (MCP_HISTOGRAM_MAX_EXPONENT - MCP_HISTOGRAM_SUB_BUCKET_BITS + 2);
+	constexpr uint64 MaxTrackableValue = (uint64(1) << (MCP_HISTOGRAM_MAX_EXPONENT + 1)) - 1;
+
+	const TCHAR* PhaseToString(EMcpLatencyPhase Phase)
+	{
+		switch (Phase)
+		{
+		case EMcpLatencyPhase::Queue:
+			return TEXT("queue");
+		case EMcpLatencyPhase::Execute:
+			return TEXT("execute");
+		case EMcpLatencyPhase::Serialize:
+			return TEXT("serialize");
+		case EMcpLatencyPhase::Send:
+			return TEXT("send");
+		case EMcpLatencyPhase::Total:
+		default:
+			return TEXT("total");
+		}
+	}
+}
+
+FMcpHistogram::FMcpHistogram()
+	: Count(0)
+	, Min(0)
+	, Max(0)
+	, Sum(0.0)
+{
+}
+
+int32 FMcpHistogram::GetBucketIndex(uint64 Value)
+{
+	if (Value < SubBucketCount)
+	{
+		return (int32)Value;
+	}
+
+	// The top MCP_HISTOGRAM_SUB_BUCKET_BITS + 1 bits select the bucket; the leading one is implied
+	const int32 Exponent = (int32)FMath::FloorLog2_64(Value);
+	const int32 Shift = Exponent - MCP_HISTOGRAM_SUB_BUCKET_BITS;
+	const int32 SubBucket = (int32)(Value >> Shift) & (SubBucketCount - 1);
+	return SubBucketCount + Shift * SubBucketCount + SubBucket;
+}
+
+uint64 FMcpHistogram::GetBucketMidpoint(int32 Index)
+{
+	if (Index < SubBucketCount)
+	{
+		return Index;
+	}
+
+	const int32 Shift = (Index - SubBucketCount) / SubBucketCount;
+	const uint64 SubBucket = (Index - SubBucketCount) % SubBucketCount;
+	const uint64 Lower = (SubBucketCount + SubBucket) << Shift;
+	return Lower + ((uint64(1) << Shift) >> 1);
+}
+
+void FMcpHistogram::Record(uint64 Value)
+{
+	Value = FMath::Min(Value, MaxTrackableValue);
+
+	if (Buckets.Num() == 0)
+	{
+		Buckets.SetNumZeroed(BucketCount);
+	}
+	Buckets[GetBucketIndex(Value)]++;
+
+	Min = Count == 0 ? Value : FMath::Min(Min, Value);
+	Max = FMath::Max(Max, Value);
+	Sum += (double)Value;
+	Count++;
+}
+
+void FMcpHistogram::Reset()
+{
+	Buckets.Empty();
+	Count = 0;
+	Min = 0;
+	Max = 0;
+	Sum = 0.0;
+}
+
+uint64 FMcpHistogram::GetPercentile(double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0;
+	}
+
+	const int64 Rank = FMath::Clamp<int64>((int64)FMath::CeilToDouble(Percentile * (double)Count), 1, Count);
+	int64 Seen = 0;
+	for (int32 Index = 0; Index < Buckets.Num(); Index++)
+	{
+		Seen += Buckets[Index];
+		if (Seen >= Rank)
+		{
+			// The exact extremes are known, so never report past them
+			return FMath::Clamp(GetBucketMidpoint(Index), Min, Max);
+		}
+	}
+	return Max;
+}
+
+TSharedPtr<FJsonObject> FMcpHistogram::ToJson(double Scale) const
+{
+	TSharedPtr<FJsonObject> HistogramObj = MakeShared<FJsonObject>();
+	HistogramObj->SetNumberField(TEXT("count"), Count);
+	HistogramObj->SetNumberField(TEXT("min"), Min * Scale);
+	HistogramObj->SetNumberField(TEXT("mean"), Count > 0 ? Sum / Count * Scale : 0.0);
+	HistogramObj->SetNumberField(TEXT("p50"), GetPercentile(0.5) * Scale);
+	HistogramObj->SetNumberField(TEXT("p90"), GetPercentile(0.9) * Scale);
+	HistogramObj->SetNumberField(TEXT("p99"), GetPercentile(0.99) * Scale);
+	HistogramObj->SetNumberField(TEXT("p999"), GetPercentile(0.999) * Scale);
+	HistogramObj->SetNumberField(TEXT("max"), Max * Scale);
+	return HistogramObj;
+}
+
+FMcpServerStats::FMcpServerStats()
+	: PeakQueueDepth(0)
+	, Rejected(0)
+	, ResetTime(FPlatformTime::Seconds())
+	, BytesReceived(0)
+	, BytesSent(0)
+{
+}
+
+uint64 FMcpServerStats::ToMicroseconds(double Seconds)
+{
+	return Seconds > 0.0 ? (uint64)(Seconds * 1000000.0) : 0;
+}
+
+FMcpServerStats::FCommandStats& FMcpServerStats::FindOrAddCommand(const FMcpCommandInfo* Command)
+{
+	static const FName UnknownName(TEXT("unknown"));
+	return Commands.FindOrAdd(Command ? Command->Name : UnknownName);
+}
+
+void FMcpServerStats::RecordReceived(const FMcpCommandInfo* Command, int64 RequestBytes)
+{
+	FScopeLock Lock(&StatsLock);
+	FCommandStats& CommandStats = FindOrAddCommand(Command);
+	CommandStats.Requests++;
+	CommandStats.BytesIn += RequestBytes;
+}
+
+void FMcpServerStats::RecordEnqueued(int32 Depth)
+{
+	FScopeLock Lock(&StatsLock);
+	QueueDepth.Record(FMath::Max(0, Depth));
+	PeakQueueDepth = FMath::Max(PeakQueueDepth, Depth);
+}
+
+void FMcpServerStats::RecordRejected(const FMcpCommandInfo* Command)
+{
+	FScopeLock Lock(&StatsLock);
+	FindOrAddCommand(Command).Rejected++;
+	Rejected++;
+}
+
+void FMcpServerStats::RecordExecution(const FMcpCommandInfo* Command, double QueueSeconds, double ExecuteSeconds, double SerializeSeconds,
+	bool bExecuted, bool bError)
+{
+	FScopeLock Lock(&StatsLock);
+	FCommandStats& CommandStats = FindOrAddCommand(Command);
+	CommandStats.Latency[(int32)EMcpLatencyPhase::Queue].Record(ToMicroseconds(QueueSeconds));
+
+	// Replays take no time worth measuring and would drag the handler's percentiles down
+	if (bExecuted)
+	{
+		CommandStats.Latency[(int32)EMcpLatencyPhase::Execute].Record(ToMicroseconds(ExecuteSeconds));
+		CommandStats.Latency[(int32)EMcpLatencyPhase::Serialize].Record(ToMicroseconds(SerializeSeconds));
+	}
+	else
+	{
+		CommandStats.Replayed++;
+	}
+
+	if (bError)
+	{
+		CommandStats.Errors++;
+	}
+}
+
+void FMcpServerStats::RecordResponseBytes(const FMcpCommandInfo* Command, int64 ResponseBytes)
+{
+	FScopeLock Lock(&StatsLock);
+	FindOrAddCommand(Command).BytesOut += ResponseBytes;
+}
+
+void FMcpServerStats::RecordDelivery(const FMcpCommandInfo* Command, int64 ResponseBytes, double SendSeconds, double TotalSeconds)
+{
+	FScopeLock Lock(&StatsLock);
+	FCommandStats& CommandStats = FindOrAddCommand(Command);
+	CommandStats.BytesOut += ResponseBytes;
+	CommandStats.Latency[(int32)EMcpLatencyPhase::Send].Record(ToMicroseconds(SendSeconds));
+	CommandStats.Latency[(int32)EMcpLatencyPhase::Total].Record(ToMicroseconds(TotalSeconds));
+}
+
+TSharedPtr<FJsonObject> FMcpServerStats::ToJson(const FString& CommandFilter) const
+{
+	TSharedPtr<FJsonObject> StatsObj = MakeShared<FJsonObject>();
+	StatsObj->SetNumberField(TEXT("bytes_in"), BytesReceived.Load());
+	StatsObj->SetNumberField(TEXT("bytes_out"), BytesSent.Load());
+
+	FScopeLock Lock(&StatsLock);
+	StatsObj->SetNumberField(TEXT("window_seconds"), FPlatformTime::Seconds() - ResetTime);
+	StatsObj->SetNumberField(TEXT("rejected_busy"), Rejected);
+
+	TSharedPtr<FJsonObject> QueueObj = MakeShared<FJsonObject>();
+	QueueObj->SetNumberField(TEXT("peak"), PeakQueueDepth);
+	QueueObj->SetObjectField(TEXT("depth_at_enqueue"), QueueDepth.ToJson());
+	StatsObj->SetObjectField(TEXT("queue"), QueueObj);
+
+	int64 TotalRequests = 0;
+	TSharedPtr<FJsonObject> CommandsObj = MakeShared<FJsonObject>();
+	for (const TPair<FName, FCommandStats>& Pair : Commands)
+	{
+		const FCommandStats& CommandStats = Pair.Value;
+		TotalRequests += CommandStats.Requests;
+		const FString CommandName = Pair.Key.ToString();
+		if (!CommandFilter.IsEmpty() && CommandName != CommandFilter)
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> CommandObj = MakeShared<FJsonObject>();
+		CommandObj->SetNumberField(TEXT("requests"), CommandStats.Requests);
+		CommandObj->SetNumberField(TEXT("errors"), CommandStats.Errors);
+		CommandObj->SetNumberField(TEXT("replayed"), CommandStats.Replayed);
+		CommandObj->SetNumberField(TEXT("rejected_busy"), CommandStats.Rejected);
+		CommandObj->SetNumberField(TEXT("bytes_in"), CommandStats.BytesIn);
+		CommandObj->SetNumberField(TEXT("bytes_out"), CommandStats.BytesOut);
+
+		// Microseconds are recorded; milliseconds read better
+		TSharedPtr<FJsonObject> LatencyObj = MakeShared<FJsonObject>();
+		for (int32 Phase = 0; Phase < (int32)EMcpLatencyPhase::Count; Phase++)
+		{
+			if (CommandStats.Latency[Phase].GetCount() > 0)
+			{
+				LatencyObj->SetObjectField(PhaseToString((EMcpLatencyPhase)Phase), CommandStats.Latency[Phase].ToJson(0.001));
+			}
+		}
+		CommandObj->SetObjectField(TEXT("latency_ms"), LatencyObj);
+
+		CommandsObj->SetObjectField(CommandName, CommandObj);
+	}
+	StatsObj->SetNumberField(TEXT("requests"), TotalRequests);
+	StatsObj->SetObjectField(TEXT("commands"), CommandsObj);
+	return StatsObj;
+}
+
+void FMcpServerStats::Reset()
+{
+	BytesReceived = 0;
+	BytesSent = 0;
+
+	FScopeLock Lock(&StatsLock);
+	Commands.Empty();
+	QueueDepth.Reset();
+	PeakQueueDepth = 0;
+	Rejected = 0;
+	ResetTime = FPlatformTime::Seconds();
+}
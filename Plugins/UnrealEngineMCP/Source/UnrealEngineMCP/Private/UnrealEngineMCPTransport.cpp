@@ -0,0 +1,324 @@
+#include "UnrealEngineMCPTransport.h"
+#include "SocketSubsystem.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+
+#if MCP_WITH_LOCAL_SOCKET
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+#define MCP_SOCKET_BUFFER_SIZE 65536
+
+namespace
+{
+	class FMcpTcpSocket : public FMcpStreamSocket
+	{
+	public:
+		explicit FMcpTcpSocket(FSocket* InSocket) : Socket(InSocket) {}
+		virtual ~FMcpTcpSocket() override { Close(); }
+
+		virtual bool Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime) override
+		{
+			return Socket && Socket->Wait(Condition, WaitTime);
+		}
+
+		virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) override
+		{
+			return Socket && Socket->Recv(Data, BufferSize, BytesRead);
+		}
+
+		virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override
+		{
+			return Socket && Socket->Send(Data, Count, BytesSent);
+		}
+
+		virtual ESocketErrors GetLastError() const override
+		{
+			return ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+		}
+
+		virtual void Close() override
+		{
+			if (Socket)
+			{
+				Socket->Close();
+				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+				Socket = nullptr;
+			}
+		}
+
+		virtual FString GetRemoteAddress() const override
+		{
+			ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+			if (!Socket || !SocketSubsystem)
+			{
+				return TEXT("unknown");
+			}
+
+			TSharedRef<FInternetAddr> PeerAddr = SocketSubsystem->CreateInternetAddr();
+			Socket->GetPeerAddress(*PeerAddr);
+			return PeerAddr->ToString(true);
+		}
+
+		virtual const TCHAR* GetTransportName() const override { return TEXT("tcp"); }
+
+	private:
+		FSocket* Socket;
+	};
+
+	class FMcpTcpListener : public FMcpListener
+	{
+	public:
+		FMcpTcpListener(FSocket* InSocket, const FString& InDescription) : Socket(InSocket), Description(InDescription) {}
+
+		virtual ~FMcpTcpListener() override
+		{
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		}
+
+		virtual bool WaitForPendingConnection(FTimespan WaitTime) override
+		{
+			bool bPending = false;
+			return Socket->WaitForPendingConnection(bPending, WaitTime) && bPending;
+		}
+
+		virtual TSharedPtr<FMcpStreamSocket> Accept() override
+		{
+			FSocket* ClientSocket = Socket->Accept(TEXT("MCPClient"));
+			if (!ClientSocket)
+			{
+				return nullptr;
+			}
+
+			// Connection threads interleave recv with response delivery, so never block in Recv
+			ClientSocket->SetNonBlocking(true);
+			ClientSocket->SetNoDelay(true);
+			int32 SocketBufferSize = MCP_SOCKET_BUFFER_SIZE;
+			ClientSocket->SetSendBufferSize(SocketBufferSize, SocketBufferSize);
+			ClientSocket->SetReceiveBufferSize(SocketBufferSize, SocketBufferSize);
+
+			return MakeShared<FMcpTcpSocket>(ClientSocket);
+		}
+
+		virtual FString Describe() const override { return Description; }
+
+	private:
+		FSocket* Socket;
+		FString Description;
+	};
+
+#if MCP_WITH_LOCAL_SOCKET
+	ESocketErrors TranslateErrno(int32 Error)
+	{
+		switch (Error)
+		{
+		case 0:
+			return SE_NO_ERROR;
+		case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+		case EWOULDBLOCK:
+#endif
+			return SE_EWOULDBLOCK;
+		case EINTR:
+			return SE_EINTR;
+		case EPIPE:
+		case ECONNRESET:
+			return SE_ECONNRESET;
+		default:
+			return SE_ENOTCONN;
+		}
+	}
+
+	bool PollDescriptor(int32 Descriptor, int16 Events, FTimespan WaitTime)
+	{
+		pollfd PollFd;
+		PollFd.fd = Descriptor;
+		PollFd.events = Events;
+		PollFd.revents = 0;
+
+		// Hang-ups and errors count as ready so the following call reports them
+		const int32 Result = poll(&PollFd, 1, (int32)WaitTime.GetTotalMilliseconds());
+		return Result > 0 && (PollFd.revents & (Events | POLLHUP | POLLERR)) != 0;
+	}
+
+	class FMcpLocalSocket : public FMcpStreamSocket
+	{
+	public:
+		explicit FMcpLocalSocket(int32 InDescriptor) : Descriptor(InDescriptor) {}
+		virtual ~FMcpLocalSocket() override { Close(); }
+
+		virtual bool Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime) override
+		{
+			const int16 Events = (Condition == ESocketWaitConditions::WaitForRead) ? POLLIN
+				: (Condition == ESocketWaitConditions::WaitForWrite) ? POLLOUT
+				: (POLLIN | POLLOUT);
+			return Descriptor >= 0 && PollDescriptor(Descriptor, Events, WaitTime);
+		}
+
+		virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) override
+		{
+			const ssize_t Result = recv(Descriptor, Data, BufferSize, 0);
+			BytesRead = (int32)FMath::Max<ssize_t>(Result, 0);
+			return Result >= 0;
+		}
+
+		virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) override
+		{
+#if PLATFORM_MAC
+			const ssize_t Result = send(Descriptor, Data, Count, 0);
+#else
+			// A client that went away must not raise SIGPIPE in the editor
+			const ssize_t Result = send(Descriptor, Data, Count, MSG_NOSIGNAL);
+#endif
+			BytesSent = (int32)FMath::Max<ssize_t>(Result, 0);
+			return Result >= 0;
+		}
+
+		virtual ESocketErrors GetLastError() const override
+		{
+			return TranslateErrno(errno);
+		}
+
+		virtual void Close() override
+		{
+			if (Descriptor >= 0)
+			{
+				shutdown(Descriptor, SHUT_RDWR);
+				close(Descriptor);
+				Descriptor = -1;
+			}
+		}
+
+		virtual FString GetRemoteAddress() const override { return TEXT("local"); }
+		virtual const TCHAR* GetTransportName() const override { return TEXT("unix"); }
+
+	private:
+		int32 Descriptor;
+	};
+
+	class FMcpLocalListener : public FMcpListener
+	{
+	public:
+		FMcpLocalListener(int32 InDescriptor, const FString& InPath) : Descriptor(InDescriptor), Path(InPath) {}
+
+		virtual ~FMcpLocalListener() override
+		{
+			close(Descriptor);
+			unlink(TCHAR_TO_UTF8(*Path));
+		}
+
+		virtual bool WaitForPendingConnection(FTimespan WaitTime) override
+		{
+			return PollDescriptor(Descriptor, POLLIN, WaitTime);
+		}
+
+		virtual TSharedPtr<FMcpStreamSocket> Accept() override
+		{
+			const int32 ClientDescriptor = accept(Descriptor, nullptr, nullptr);
+			if (ClientDescriptor < 0)
+			{
+				return nullptr;
+			}
+
+			fcntl(ClientDescriptor, F_SETFL, fcntl(ClientDescriptor, F_GETFL, 0) | O_NONBLOCK);
+			fcntl(ClientDescriptor, F_SETFD, FD_CLOEXEC);
+#if PLATFORM_MAC
+			int32 NoSigPipe = 1;
+			setsockopt(ClientDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+			int32 SocketBufferSize = MCP_SOCKET_BUFFER_SIZE;
+			setsockopt(ClientDescriptor, SOL_SOCKET, SO_SNDBUF, &SocketBufferSize, sizeof(SocketBufferSize));
+			setsockopt(ClientDescriptor, SOL_SOCKET, SO_RCVBUF, &SocketBufferSize, sizeof(SocketBufferSize));
+
+			return MakeShared<FMcpLocalSocket>(ClientDescriptor);
+		}
+
+		virtual FString Describe() const override { return FString::Printf(TEXT("unix:%s"), *Path); }
+
+	private:
+		int32 Descriptor;
+		FString Path;
+	};
+#endif
+}
+
+TSharedPtr<FMcpListener> McpTransport::CreateTcpListener(const FIPv4Address& Address, uint16 Port, int32 Backlog)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("McpTransport: Failed to get socket subsystem"));
+		return nullptr;
+	}
+
+	FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealEngineMCPListener"), false);
+	if (!Socket)
+	{
+		UE_LOG(LogTemp, Error, TEXT("McpTransport: Failed to create listener socket"));
+		return nullptr;
+	}
+
+	Socket->SetReuseAddr(true);
+	Socket->SetNonBlocking(true);
+
+	FIPv4Endpoint Endpoint(Address, Port);
+	if (!Socket->Bind(*Endpoint.ToInternetAddr()) || !Socket->Listen(Backlog))
+	{
+		UE_LOG(LogTemp, Error, TEXT("McpTransport: Failed to listen on %s:%d"), *Address.ToString(), Port);
+		SocketSubsystem->DestroySocket(Socket);
+		return nullptr;
+	}
+
+	return MakeShared<FMcpTcpListener>(Socket, FString::Printf(TEXT("tcp:%s:%d"), *Address.ToString(), Port));
+}
+
+TSharedPtr<FMcpListener> McpTransport::CreateLocalListener(const FString& Path, int32 Backlog)
+{
+#if MCP_WITH_LOCAL_SOCKET
+	FTCHARToUTF8 UTF8Path(*Path);
+	sockaddr_un Address;
+	FMemory::Memzero(Address);
+	Address.sun_family = AF_UNIX;
+	if (UTF8Path.Length() >= (int32)sizeof(Address.sun_path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("McpTransport: Local socket path too long: %s"), *Path);
+		return nullptr;
+	}
+	FMemory::Memcpy(Address.sun_path, UTF8Path.Get(), UTF8Path.Length());
+
+	const int32 Descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Descriptor < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("McpTransport: Failed to create local socket (errno %d)"), errno);
+		return nullptr;
+	}
+	fcntl(Descriptor, F_SETFD, FD_CLOEXEC);
+
+	// A previous editor that crashed leaves its socket file behind
+	unlink(UTF8Path.Get());
+
+	// Owner-only; nobody can connect before listen(), so restricting after bind leaves no window
+	if (bind(Descriptor, (const sockaddr*)&Address, sizeof(Address)) != 0
+		|| chmod(UTF8Path.Get(), S_IRUSR | S_IWUSR) != 0
+		|| listen(Descriptor, Backlog) != 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("McpTransport: Failed to listen on %s (errno %d)"), *Path, errno);
+		close(Descriptor);
+		return nullptr;
+	}
+
+	return MakeShared<FMcpLocalListener>(Descriptor, Path);
+#else
+	return nullptr;
+#endif
+}
+
+FString McpTransport::GetDefaultLocalSocketPath(uint16 Port)
+{
+	return FString::Printf(TEXT("/tmp/unreal-mcp-%d.sock"), Port);
+}
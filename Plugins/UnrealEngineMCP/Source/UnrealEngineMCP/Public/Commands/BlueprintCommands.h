@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+class FMcpResponseWriter;
+class FMcpCommandRegistry;
+
 /**
  * Handles Blueprint-related commands (assets and node graph)
  */
@@ -13,10 +16,12 @@ public:
 	~FBlueprintCommands();
 
 	/**
-	 * Handle blueprint command
-	 * Routes to specific handler based on command type
+	 * Register the blueprint commands and their metadata with the bridge
 	 */
-	TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	void RegisterCommands(FMcpCommandRegistry& Registry);
+
+	// Streaming handlers - write the full response envelope into Writer
+	void HandleAnalyzeBlueprint(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& Writer);
 
 private:
 	// Blueprint asset commands
@@ -46,7 +51,6 @@ private:
 	TSharedPtr<FJsonObject> HandleAddCommentBox(const TSharedPtr<FJsonObject>& Params);
 
 	// Blueprint analysis commands
-	TSharedPtr<FJsonObject> HandleAnalyzeBlueprint(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleListGraphs(const TSharedPtr<FJsonObject>& Params);
 
 	// GAS (Gameplay Ability System) commands
@@ -82,6 +82,12 @@ public:
 	// Blueprint
 	static UBlueprint* FindBlueprint(const FString& BlueprintName, const FString& BlueprintPath = TEXT("/Game/Blueprints/"));
 	static UBlueprint* FindBlueprintByName(const FString& BlueprintName, const FString& BlueprintPath = TEXT("/Game/Blueprints/"));
+
+	// Recompile after an edit. While deferral is on (transactional batches) the blueprint is only
+	// recorded, and EndDeferredCompilation hands back everything to compile at commit time.
+	static void CompileBlueprint(UBlueprint* Blueprint);
+	static void BeginDeferredCompilation();
+	static TArray<UBlueprint*> EndDeferredCompilation();
 	static bool SetObjectProperty(UObject* Object, const FString& PropertyName,
 	                              const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage);
 
@@ -3,11 +3,14 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 #include "GameplayTagContainer.h"
+#include "UnrealEngineMCPJobs.h"
 
 // Forward declarations for World Partition
 class UWorldPartition;
 class FWorldPartitionActorDesc;
 class FWorldPartitionActorDescInstance;
+class FMcpResponseWriter;
+class FMcpCommandRegistry;
 
 /**
  * Handles editor and actor commands (spawn, delete, transform, find, modify)
@@ -20,15 +23,20 @@ public:
 	~FEditorCommands();
 
 	/**
-	 * Handle editor/actor command
-	 * Routes to specific handler based on command type
+	 * Register the editor/actor commands and their metadata with the bridge
 	 */
-	TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	void RegisterCommands(FMcpCommandRegistry& Registry);
+
+	// Streaming handlers - write the full response envelope into Writer
+	void HandleListLevelActors(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& Writer);
+	void HandleSearchActors(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& Writer);
+
+	// set_region_loaded as a job: actors are found in the first slice, then loaded a few per slice
+	FMcpJobSliceFunction MakeSetRegionLoadedJob(const TSharedPtr<FJsonObject>& Params);
 
 private:
 	// Editor command handlers
 	TSharedPtr<FJsonObject> HandleSpawnActor(const TSharedPtr<FJsonObject>& Params);
-	TSharedPtr<FJsonObject> HandleListLevelActors(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params);
@@ -36,9 +44,6 @@ private:
 	TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleCreateMaterial(const TSharedPtr<FJsonObject>& Params);
 
-	// Actor command handlers
-	TSharedPtr<FJsonObject> HandleSearchActors(const TSharedPtr<FJsonObject>& Params);
-
 	// Material commands
 	TSharedPtr<FJsonObject> HandleApplyMaterialToActor(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleGetActorMaterialInfo(const TSharedPtr<FJsonObject>& Params);
@@ -54,6 +59,12 @@ private:
 	TSharedPtr<FJsonObject> HandleSetRegionLoaded(const TSharedPtr<FJsonObject>& Params);
 	TSharedPtr<FJsonObject> HandleGetWorldPartitionInfo(const TSharedPtr<FJsonObject>& Params);
 
+	// Region loading, shared by the command and its job
+	bool ParseRegionParams(const TSharedPtr<FJsonObject>& Params, bool& bOutLoad, FVector& OutCenter, float& OutRadius, FString& OutError);
+	TSharedPtr<FJsonObject> MakeRegionResult(bool bIsLoad, const FVector& Center, float Radius);
+	void CollectUnloadedActorsInRegion(UWorldPartition* WorldPartition, const FBox& RegionBox, TArray<FGuid>& OutActorGuids);
+	int32 LoadActors(UWorldPartition* WorldPartition, TArrayView<const FGuid> ActorGuids);
+
 	// Helpers
 	void AddAssetTypeFilter(FARFilter& Filter, const FString& AssetType);
 	TSharedPtr<FJsonObject> ActorDescInstanceToJson(const FWorldPartitionActorDescInstance* ActorDescInstance, bool bIsLoaded);
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+class FMcpCommandRegistry;
+
 /**
  * Handles PCG (Procedural Content Generation) commands
  */
@@ -13,10 +15,9 @@ public:
 	~FPCGCommands();
 
 	/**
-	 * Handle PCG command
-	 * Routes to specific handler based on command type
+	 * Register the PCG commands and their metadata with the bridge
 	 */
-	TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	void RegisterCommands(FMcpCommandRegistry& Registry);
 
 private:
 	// PCG Graph asset commands
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+class FMcpCommandRegistry;
+
 /**
  * Handles Python code execution in Unreal Engine
  * This is the key handler for RAG-generated code
@@ -13,6 +15,9 @@ public:
 	FPythonExecutor();
 	~FPythonExecutor();
 
+	// Register execute_python with the bridge
+	void RegisterCommands(FMcpCommandRegistry& Registry);
+
 	/**
 	 * Execute Python code in Unreal's Python environment
 	 * Used by RAG tool to run generated code
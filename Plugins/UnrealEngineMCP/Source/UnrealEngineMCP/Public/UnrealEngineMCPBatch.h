@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+class UBlueprint;
+
+/**
+ * References between the steps of a batch
+ *
+ * A string parameter that is exactly "$stepN" or "$stepN.path" takes the value found at that
+ * path in the result of step N (0-based, as reported in "index"), keeping its JSON type.
+ * Inside a longer string, "${stepN.path}" is replaced by the value's text. Paths use field
+ * names and array indices: "node_id", "pins[0].name". "$$stepN..." is the literal "$stepN...".
+ */
+namespace McpBatch
+{
+	// StepResults[N] is the "result" object of step N, or null if that step did not succeed.
+	// OutParams is Params itself when nothing references another step.
+	bool ResolveReferences(const TSharedPtr<FJsonObject>& Params, const TArray<TSharedPtr<FJsonObject>>& StepResults,
+		TSharedPtr<FJsonObject>& OutParams, FString& OutError);
+
+	// Value at a dotted/indexed path within Root; the empty path is Root itself
+	TSharedPtr<FJsonValue> FindPath(const TSharedPtr<FJsonObject>& Root, const FString& Path);
+}
+
+/**
+ * Undo transaction spanning a transactional ("transaction": true) batch
+ * Command handlers edit blueprints and actors without calling Modify(), so before each step the
+ * objects its params name (blueprint_name/blueprint_path, name/actor_name, asset_path/graph_path)
+ * are snapshotted into the transaction. Blueprint compilation is deferred until Commit.
+ * Asset creation, deletion and saving are not undoable and are not rolled back.
+ */
+class FMcpBatchTransaction
+{
+public:
+	explicit FMcpBatchTransaction(const FString& Description);
+	~FMcpBatchTransaction();
+
+	bool IsOpen() const { return bOpen; }
+
+	void CaptureTargets(const TSharedPtr<FJsonObject>& Params);
+
+	// End the transaction and compile the blueprints the batch edited; returns their names
+	TArray<FString> Commit();
+
+	// End the transaction and undo everything recorded in it
+	void Rollback();
+
+private:
+	void CaptureObject(UObject* Object);
+	void CaptureBlueprint(UBlueprint* Blueprint);
+
+	bool bOpen;
+	TSet<const UObject*> Captured;
+	TArray<TWeakObjectPtr<UBlueprint>> CapturedBlueprints;
+};
@@ -8,14 +8,44 @@
 #include "Dom/JsonObject.h"
 #include "Containers/Queue.h"
 #include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+#include "UnrealEngineMCPResponseWriter.h"
+#include "UnrealEngineMCPScheduler.h"
+#include "UnrealEngineMCPCommandRegistry.h"
+#include "UnrealEngineMCPJobs.h"
+#include "UnrealEngineMCPIdempotency.h"
+#include "UnrealEngineMCPResponseCache.h"
+#include "UnrealEngineMCPEvents.h"
+#include "UnrealEngineMCPStats.h"
 #include "UnrealEngineMCPBridge.generated.h"
 
 class FMcpServerRunnable;
+class FMcpConnectionManager;
+class FMcpListener;
 class FEditorCommands;
 class FBlueprintCommands;
 class FPCGCommands;
 class FPythonExecutor;
 
+/**
+ * Wakes a waiting network thread when a response is stored
+ * Shared so it stays valid if the connection goes away before the command completes
+ */
+class FMcpCompletionSignal
+{
+public:
+	FMcpCompletionSignal() : Event(FPlatformProcess::GetSynchEventFromPool(false)) {}
+	~FMcpCompletionSignal() { FPlatformProcess::ReturnSynchEventToPool(Event); }
+
+	void Trigger() { Event->Trigger(); }
+	bool Wait(uint32 WaitTimeMs) { return Event->Wait(WaitTimeMs); }
+
+private:
+	FEvent* Event;
+};
+
+typedef TSharedPtr<FMcpCompletionSignal, ESPMode::ThreadSafe> FMcpCompletionSignalPtr;
+
 // Command request structure
 struct FMcpCommandRequest
 {
@@ -23,22 +53,23 @@ struct FMcpCommandRequest
 	FString CommandType;
 	TSharedPtr<FJsonObject> Params;
 	double Timestamp;
+	FMcpCompletionSignalPtr CompletionSignal;
+	FMcpResponseStreamPtr Stream;
+	EMcpEncoding Encoding;
+	uint32 ConnectionId;  // For per-connection fairness; 0 when not sent by a client connection
+	FMcpCancellationTokenPtr Cancellation;
+	FMcpResponseSlotPtr ResponseSlot;  // Receives the serialized envelope, in Encoding
+	FString IdempotencyKey;  // Client-chosen; a retry with the same key replays the first response
+	const FMcpCommandInfo* Command;  // Registry entry for CommandType, null for unknown commands
+	bool bAnyThread;  // May run on the thread pool: an AnyThread command whose params keep it off Blueprint classes
 
-	FMcpCommandRequest() : RequestId(0), Timestamp(0.0) {}
-	FMcpCommandRequest(uint32 InId, const FString& InType, TSharedPtr<FJsonObject> InParams)
-		: RequestId(InId), CommandType(InType), Params(InParams), Timestamp(FPlatformTime::Seconds()) {}
-};
-
-// Command response structure
-struct FMcpCommandResponse
-{
-	uint32 RequestId;
-	FString Response;
-	bool bSuccess;
-
-	FMcpCommandResponse() : RequestId(0), bSuccess(false) {}
-	FMcpCommandResponse(uint32 InId, const FString& InResponse, bool InSuccess)
-		: RequestId(InId), Response(InResponse), bSuccess(InSuccess) {}
+	FMcpCommandRequest() : RequestId(0), Timestamp(0.0), Encoding(EMcpEncoding::Json), ConnectionId(0), Command(nullptr), bAnyThread(false) {}
+	FMcpCommandRequest(uint32 InId, const FString& InType, TSharedPtr<FJsonObject> InParams, FMcpCompletionSignalPtr InSignal = nullptr,
+		FMcpResponseStreamPtr InStream = nullptr, EMcpEncoding InEncoding = EMcpEncoding::Json, uint32 InConnectionId = 0,
+		FMcpCancellationTokenPtr InCancellation = nullptr, const FString& InIdempotencyKey = FString())
+		: RequestId(InId), CommandType(InType), Params(InParams), Timestamp(FPlatformTime::Seconds()), CompletionSignal(InSignal), Stream(InStream)
+		, Encoding(InEncoding), ConnectionId(InConnectionId), Cancellation(InCancellation)
+		, ResponseSlot(MakeShared<FMcpResponseSlot, ESPMode::ThreadSafe>()), IdempotencyKey(InIdempotencyKey), Command(nullptr), bAnyThread(false) {}
 };
 
 /**
@@ -69,26 +100,117 @@ public:
 	bool IsRunning() const { return bIsRunning; }
 
 	// Queue-based command handling (called from network thread)
-	bool EnqueueCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, uint32& OutRequestId);
-	bool TryDequeueResponse(uint32 RequestId, FMcpCommandResponse& OutResponse);
-	bool WaitForResponse(uint32 RequestId, FMcpCommandResponse& OutResponse, float TimeoutSeconds = 30.0f);
+	// CompletionSignal is triggered once the response for the request is available
+	// Stream (optional) receives partial results from handlers that support streaming
+	// Encoding selects how the response body is serialized
+	// ConnectionId keeps a connection's requests in submission order and shares the game thread fairly between connections
+	// Cancellation (optional) lets the caller stop the command before or while it runs; abandoning it
+	// (the caller stopped waiting) also means no response is stored.
+	// IdempotencyKey (optional) makes a retried mutation replay the first response instead of running again
+	// Returns the slot the response will be handed over in, or null when the queue is full.
+	FMcpResponseSlotPtr EnqueueCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, uint32& OutRequestId,
+		FMcpCompletionSignalPtr CompletionSignal = nullptr, FMcpResponseStreamPtr Stream = nullptr, EMcpEncoding Encoding = EMcpEncoding::Json,
+		uint32 ConnectionId = 0, FMcpCancellationTokenPtr Cancellation = nullptr, const FString& IdempotencyKey = FString());
 	int32 GetPendingCommandCount() const { return PendingCommandCount.Load(); }
 
+	// Outstanding/unclaimed/expired response slot counts and idempotent replays
+	TSharedPtr<FJsonObject> GetResponseStatsJson() const;
+
+	// Latency histograms and traffic counters, recorded by connections as well (any thread)
+	FMcpServerStats& GetServerStats() { return ServerStats; }
+
+	// Registry entry for a command name, null when unknown (any thread once the server runs)
+	const FMcpCommandInfo* FindCommand(const FString& CommandType) const { return Commands.Find(CommandType); }
+
+	// Editor change events for a connection's "subscribe" (called from network thread)
+	void Subscribe(const FMcpResponseStreamPtr& Stream, EMcpEventTopic Topics, EMcpEncoding Encoding);
+	void Unsubscribe(const FMcpResponseStreamPtr& Stream);
+
 private:
-	// Process pending commands on Game Thread
+	// Process pending commands on Game Thread, within TickBudgetSeconds per tick, in Scheduler order
 	void ProcessCommandQueue();
 
-	// Execute single command and generate response
-	FString ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	// A connection's requests are counted until they complete, on the game thread and on workers (any thread).
+	// A read only starts on a worker when nothing the connection sent earlier is still waiting for the
+	// game thread (bQueued: the request itself is leaving the scheduler), and a game-thread request only
+	// starts once the reads sent before it have finished, so neither overtakes the other.
+	bool TryStartOnWorker(const FMcpCommandRequest& Request, bool bQueued);
+	bool CanStartOnGameThread(const FMcpCommandRequest& Request) const;
+	void EnqueueForGameThread(FMcpCommandRequest&& Request);
+	void ReleaseRequest(uint32 ConnectionId, bool bOnWorker);
+
+	// Run a request TryStartOnWorker accepted on the thread pool
+	void ExecuteOnWorker(FMcpCommandRequest&& Request);
+
+	// Hand the finished response to the request's slot and wake the connection waiting for it (any thread)
+	void CompleteRequest(const FMcpCommandRequest& Request, FMcpResponseWriter& ResponseWriter);
+
+	// Answer a request cancelled while it was queued without running it; false if it should run
+	bool DiscardIfCancelled(const FMcpCommandRequest& Request);
 
-	// Server state
+	// Release results nobody has collected within ResponseTtlSeconds (game thread)
+	void ExpireUnclaimedResponses(double Now);
+
+	// Smoothed execution time per command type, measured on the game thread
+	double EstimateCommandCost(const FString& CommandType) const;
+	void RecordCommandCost(const FString& CommandType, double Seconds);
+
+	// Execute a request, or replay the stored response of an earlier one with the same idempotency
+	// key or the cached response of an identical query. False when the response was replayed.
+	bool ExecuteRequest(const FMcpCommandRequest& Request, FMcpResponseWriter& ResponseWriter);
+
+	// Execute single command, writing the response envelope into ResponseWriter
+	void ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& ResponseWriter);
+
+	// Route to the registered handler for CommandType; false for unknown commands.
+	// OutResult stays null when a streaming handler wrote its envelope into ResponseWriter itself.
+	bool DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& ResponseWriter, TSharedPtr<FJsonObject>& OutResult);
+
+	// Fill Commands from every handler class, and add the bridge's own commands
+	void RegisterCommands();
+
+	// Commands implemented by the bridge itself
+	TSharedPtr<FJsonObject> HandlePing(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleListConnections(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleListCommands(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleJobStatus(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleCancelJob(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleListJobs(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleGetServerStats(const TSharedPtr<FJsonObject>& Params);
+
+	// {"status":"success","result":...} or {"status":"error","error":...} for a handler result
+	static TSharedPtr<FJsonObject> MakeEnvelope(const TSharedPtr<FJsonObject>& ResultJson);
+	static TSharedPtr<FJsonObject> MakeErrorEnvelope(const FString& Message);
+
+	// "async": true on a long-running command: queue it as a job and return the job id
+	TSharedPtr<FJsonObject> SubmitJob(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	// batch: run an ordered list of sub-commands back-to-back within one game-thread pass.
+	// Step params may reference earlier results ("$step2.node_id"), see McpBatch.
+	// With "transaction": true the batch is undone as a whole on the first failure or on cancellation.
+	void HandleBatch(const TSharedPtr<FJsonObject>& Params, FMcpResponseWriter& ResponseWriter);
+	TSharedPtr<FJsonObject> ExecuteBatchStep(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	// Server state - one accept thread per listener (TCP, plus the local socket where supported)
 	bool bIsRunning;
-	TSharedPtr<FSocket> ListenerSocket;
-	FRunnableThread* ServerThread;
+	TArray<TSharedPtr<FMcpListener>> Listeners;
+	TArray<FRunnableThread*> ServerThreads;
 
 	// Server configuration
 	FIPv4Address ServerAddress;
 	uint16 Port;
+	int32 MaxConnections;
+	int32 MaxQueuedCommands;  // Requests queued or running at once, across all connections
+	FString LocalSocketPath;  // Empty disables the local socket listener
+	double TickBudgetSeconds;  // Game-thread time spent on commands per editor tick
+	int32 MaxWorkerCommands;   // Concurrent AnyThread commands on the thread pool; 0 runs everything on the game thread
+	double ResponseTtlSeconds;  // How long a finished response waits to be collected
+
+	// Live client connections (each serviced on its own thread)
+	TSharedPtr<FMcpConnectionManager> ConnectionManager;
+
+	// Every command the bridge accepts; written in Initialize, read-only once the server runs
+	FMcpCommandRegistry Commands;
 
 	// Command handlers
 	TSharedPtr<FEditorCommands> EditorCommandHandler;
@@ -98,12 +220,47 @@ private:
 
 	// Command queues (thread-safe)
 	TQueue<FMcpCommandRequest, EQueueMode::Mpsc> CommandQueue;  // Multi-producer, single-consumer
-	TMap<uint32, FMcpCommandResponse> ResponseMap;
-	FCriticalSection ResponseMapLock;
+
+	// Priority lanes the game thread moves CommandQueue arrivals into (game thread only)
+	FMcpCommandScheduler Scheduler;
+
+	// Requests of one connection that have not completed yet
+	struct FOutstandingRequests
+	{
+		int32 GameThread = 0;  // In CommandQueue, the scheduler or running on the game thread
+		int32 Worker = 0;      // Running on the thread pool
+	};
+	TMap<uint32, FOutstandingRequests> OutstandingRequests;
+	mutable FCriticalSection OutstandingRequestsLock;
+
+	// Fulfilled response slots, pushed by whichever thread completed them and watched by the
+	// game thread until they are collected or expire
+	TQueue<FMcpResponseSlotWeakPtr, EQueueMode::Mpsc> FulfilledSlots;
+	TArray<FMcpResponseSlotWeakPtr> UnclaimedSlots;  // Game thread only
+	double LastResponseSweepTime;
+
+	// Long-running commands, sliced across ticks after the queued commands
+	FMcpJobManager Jobs;
+
+	// Responses of recent requests that carried an idempotency key
+	FMcpIdempotencyCache IdempotentResults;
+
+	// Responses of repeated queries, valid until the editor state they read changes
+	FMcpResponseCache ResponseCache;
+
+	// Per-command latency per phase, queue depth and traffic, for "get_server_stats"
+	FMcpServerStats ServerStats;
+
+	// Editor change notifications for subscribed connections, flushed once per tick
+	TSharedPtr<FMcpEventHub> Events;
+
+	// Game thread only
+	TMap<FString, double> CommandCostSeconds;
 
 	// Request ID counter
 	TAtomic<uint32> NextRequestId;
 
-	// Queue size tracking for overflow protection
+	// Queue size tracking for overflow protection (includes commands running on workers)
 	TAtomic<int32> PendingCommandCount;
+	TAtomic<int32> ActiveWorkerCommands;
 };
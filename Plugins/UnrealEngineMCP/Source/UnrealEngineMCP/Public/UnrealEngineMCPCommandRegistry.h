@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "UnrealEngineMCPScheduler.h"
+
+class FMcpResponseWriter;
+
+// Handler returning a result object; the bridge wraps it in the response envelope
+DECLARE_DELEGATE_RetVal_OneParam(TSharedPtr<FJsonObject>, FMcpCommandDelegate, const TSharedPtr<FJsonObject>& /* Params */);
+
+// Streaming handler that writes the full response envelope into the writer itself
+DECLARE_DELEGATE_TwoParams(FMcpStreamingCommandDelegate, const TSharedPtr<FJsonObject>& /* Params */, FMcpResponseWriter& /* Writer */);
+
+enum class EMcpParamType : uint8
+{
+	String,
+	Number,
+	Boolean,
+	Array,
+	Object,
+	Any
+};
+
+struct FMcpParamSpec
+{
+	FString Name;
+	EMcpParamType Type;
+	bool bRequired;
+};
+
+/**
+ * A registered command: its handler and what the bridge needs to know before running it
+ * Filled in fluently where the handler class registers it:
+ *
+ *   Registry.Add(TEXT("get_class_functions"), FMcpCommandDelegate::CreateRaw(this, &FBlueprintCommands::HandleGetClassFunctions))
+ *       .ReadOnly()
+ *       .ThreadSafe()
+ *       .Required(TEXT("class_name"), EMcpParamType::String);
+ */
+struct FMcpCommandInfo
+{
+	FName Name;
+	FMcpCommandDelegate Handler;
+	FMcpStreamingCommandDelegate StreamingHandler;  // Bound instead of Handler for streaming commands
+
+	EMcpPriority CostClass = EMcpPriority::Interactive;            // Scheduler lane
+	EMcpThreadAffinity Affinity = EMcpThreadAffinity::GameThread;
+	bool bReadOnly = false;         // Changes no state at all, in the editor or the bridge
+	bool bBridgeStateOnly = false;  // Changes only the bridge's own state (jobs), so cached queries stay valid
+	bool bSupportsJobs = false;     // Runs as a job when sent with "async": true
+	TArray<FMcpParamSpec> Params;
+
+	FMcpCommandInfo& ReadOnly() { bReadOnly = true; return *this; }
+	FMcpCommandInfo& BridgeStateOnly() { bBridgeStateOnly = true; return *this; }
+	FMcpCommandInfo& Cost(EMcpPriority InCostClass) { CostClass = InCostClass; return *this; }
+	FMcpCommandInfo& ThreadSafe() { Affinity = EMcpThreadAffinity::AnyThread; return *this; }
+	FMcpCommandInfo& Async() { bSupportsJobs = true; return *this; }
+	FMcpCommandInfo& Required(const TCHAR* ParamName, EMcpParamType Type) { Params.Add({ ParamName, Type, true }); return *this; }
+	FMcpCommandInfo& Optional(const TCHAR* ParamName, EMcpParamType Type) { Params.Add({ ParamName, Type, false }); return *this; }
+
+	bool IsStreaming() const { return StreamingHandler.IsBound(); }
+};
+
+/**
+ * Command name -> handler and metadata
+ * Command handler classes add their commands when the bridge initializes, before the server
+ * starts; after that the registry is only read, from any thread, without locking. Lookups hash
+ * the name once instead of comparing it against every known command.
+ */
+class FMcpCommandRegistry
+{
+public:
+	FMcpCommandInfo& Add(const TCHAR* CommandName, FMcpCommandDelegate Handler);
+	FMcpCommandInfo& Add(const TCHAR* CommandName, FMcpStreamingCommandDelegate Handler);
+
+	// Null for unknown commands. Names that were never registered are not added to the name table.
+	const FMcpCommandInfo* Find(const FString& CommandType) const;
+
+	int32 Num() const { return Commands.Num(); }
+	void Reset() { Commands.Empty(); }
+
+	// list_commands: every command with its metadata and parameters, sorted by name
+	TSharedPtr<FJsonObject> ToJson() const;
+
+private:
+	FMcpCommandInfo& AddInfo(const TCHAR* CommandName);
+
+	// Entries are boxed so the pointers requests keep stay valid
+	TMap<FName, TUniquePtr<FMcpCommandInfo>> Commands;
+};
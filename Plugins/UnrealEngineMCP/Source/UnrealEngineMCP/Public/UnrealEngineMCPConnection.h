@@ -0,0 +1,179 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "UnrealEngineMCPTransport.h"
+#include "HAL/PlatformTime.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "Async/Future.h"
+#include "UnrealEngineMCPBridge.h"
+#include "UnrealEngineMCPFraming.h"
+#include "UnrealEngineMCPEncoding.h"
+
+class FRunnableThread;
+class FEvent;
+
+// Tagged requests a connection may have outstanding; the reader stops reading at this many
+#define MCP_MAX_INFLIGHT_PER_CONNECTION 32
+
+// Snapshot of a single connection's counters
+struct FMcpConnectionStats
+{
+	uint32 ConnectionId = 0;
+	FString RemoteAddress;
+	FString Transport;
+	double ConnectedAt = 0.0;
+	int64 BytesReceived = 0;
+	int64 BytesSent = 0;
+	int32 CommandsReceived = 0;
+	int32 CommandsCompleted = 0;
+	int32 CommandsRejected = 0;
+	int32 InFlight = 0;
+	FString Framing;
+	FString Encoding;
+	FString Compression;
+	int32 CompressedResponses = 0;
+	int64 CompressionSavedBytes = 0;
+
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+// A request that was enqueued on behalf of this connection and has not been answered yet
+struct FMcpInFlightRequest
+{
+	FString ClientId;     // Serialized JSON id from the envelope; empty for untagged (legacy) requests
+	FString CommandType;
+	const FMcpCommandInfo* Command;  // Registry entry, null for unknown commands
+	double StartTime;
+	double LastProgressTime;  // Start, or the last partial result of a streamed request
+	FMcpResponseStreamPtr Stream;
+	FMcpCancellationTokenPtr Cancellation;
+	FMcpResponseSlotPtr ResponseSlot;  // Final response, handed over by the bridge without a shared lock
+
+	FMcpInFlightRequest() : Command(nullptr), StartTime(0.0), LastProgressTime(0.0) {}
+	FMcpInFlightRequest(const FString& InClientId, const FString& InCommandType, const FMcpCommandInfo* InCommand, const FMcpResponseStreamPtr& InStream,
+		const FMcpCancellationTokenPtr& InCancellation, const FMcpResponseSlotPtr& InResponseSlot)
+		: ClientId(InClientId), CommandType(InCommandType), Command(InCommand), StartTime(FPlatformTime::Seconds()), LastProgressTime(StartTime), Stream(InStream)
+		, Cancellation(InCancellation), ResponseSlot(InResponseSlot) {}
+};
+
+/**
+ * One accepted MCP client socket with its own receive buffer, feeding the bridge CommandQueue
+ *
+ * The connection thread blocks on socket readability and dispatches requests. A writer task
+ * blocks on the connection's completion signal (triggered by the bridge when it fills one of the
+ * requests' response slots) and writes responses as soon as they are available. Neither side sleep-polls.
+ *
+ * Requests carrying an "id" are pipelined: many may be in flight and responses are written
+ * as soon as each completes, tagged with the same id. Requests without an "id" keep the
+ * legacy one-at-a-time behavior.
+ *
+ * Framing defaults to newline-delimited JSON. A "negotiate" message sent while nothing is in
+ * flight can switch the connection to length-prefixed frames, and on those can switch requests
+ * and responses to CBOR and enable LZ4/zlib compression of responses above a size threshold.
+ *
+ * Tagged requests with "stream": true receive "partial" frames while the handler runs, then the
+ * final response. A "cancel" message naming a request id drops it if still queued, or stops a
+ * handler that polls for cancellation. "deadline_ms" on a request bounds how long the client waits:
+ * past it the request is answered with "Deadline exceeded" and its command is cancelled.
+ * "idempotency_key" lets a client resend a request after a dropped connection without running a
+ * mutation twice: the bridge replays the response of the first execution.
+ *
+ * "ping" is answered on this thread, so it reports liveness even while the game thread is busy.
+ *
+ * "subscribe" (tagged, optional "topics": ["actors", "assets", "blueprints"]) answers at once and
+ * then pushes {"status":"event",...} frames with the same id whenever the editor changes, until
+ * "unsubscribe" names that id or the connection closes.
+ */
+class FMcpClientConnection : public FRunnable
+{
+public:
+	FMcpClientConnection(UUnrealEngineMCPBridge* InBridge, uint32 InConnectionId, TSharedPtr<FMcpStreamSocket> InSocket);
+	virtual ~FMcpClientConnection();
+
+	// Spawn the connection thread
+	bool Start();
+
+	// Stop the connection thread and close the socket (blocks until the thread exits)
+	void Shutdown();
+
+	bool IsFinished() const { return bFinished; }
+	uint32 GetConnectionId() const { return ConnectionId; }
+	FMcpConnectionStats GetStats() const;
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	virtual void Exit() override;
+
+protected:
+	// Reader side (connection thread)
+	bool ProcessReceiveBuffer();
+	bool HandleMessage(FUtf8StringView Message);
+	bool HandleBinaryMessage(TArrayView<const uint8> Message);
+	bool DispatchMessage(const TSharedPtr<FJsonObject>& JsonObject, int32 MessageBytes);
+	bool HandleNegotiate(const FString& ClientId, const TSharedPtr<FJsonObject>& Params);
+	bool HandleCancel(const FString& ClientId, const TSharedPtr<FJsonObject>& Params);
+	bool HandlePing(const FString& ClientId);
+	bool HandleSubscribe(const FString& ClientId, const TSharedPtr<FJsonObject>& Params);
+	bool HandleUnsubscribe(const FString& ClientId, const TSharedPtr<FJsonObject>& Params);
+	bool HasCapacity() const;
+
+	// Writer side (writer task)
+	void RunWriter();
+	bool DeliverCompletedResponses(bool& bOutDelivered);
+
+	// Either side - serialized by SendLock
+	bool SendResponse(const FString& ClientId, const FString& Response);
+	bool SendResponse(const FString& ClientId, const FMcpResponseBody& Body);
+	bool SendCompressedResponse(const TArray<uint8>& IdPrefix, const FMcpResponseBody& Body, int32 SkipBytes);
+	bool SendBytes(const uint8* Data, int32 Count);
+
+	// Connection-generated JSON envelope, re-encoded for CBOR connections
+	FMcpResponseBody EncodeResponse(const FString& Response) const;
+
+private:
+	UUnrealEngineMCPBridge* Bridge;
+	uint32 ConnectionId;
+	TSharedPtr<FMcpStreamSocket> Socket;
+	FString RemoteAddress;
+	FRunnableThread* Thread;
+	TFuture<void> WriterFuture;
+
+	TAtomic<bool> bRunning;
+	TAtomic<bool> bFinished;
+
+	// Triggered by the bridge when any of this connection's responses is ready
+	FMcpCompletionSignalPtr CompletionSignal;
+
+	// Triggered by the writer when in-flight capacity frees up
+	FEvent* CapacityEvent;
+
+	// Pipelining state shared by reader and writer
+	TMap<uint32, FMcpInFlightRequest> InFlightRequests;
+	TMap<FString, FMcpResponseStreamPtr> Subscriptions;  // Subscribe request id -> its event frames
+	bool bAwaitingUntaggedResponse;
+	mutable FCriticalSection InFlightLock;
+
+	// Receive side (connection thread only)
+	FMcpReceiveBuffer ReceiveBuffer;
+
+	// Written by the reader under SendLock; read by senders under SendLock
+	EMcpFraming Framing;
+	EMcpEncoding Encoding;
+	EMcpCompression Compression;
+	int32 CompressionThreshold;
+	FCriticalSection SendLock;
+
+	// Stats (written on the connection threads, read from the game thread)
+	double ConnectedAt;
+	TAtomic<int64> BytesReceived;
+	TAtomic<int64> BytesSent;
+	TAtomic<int32> CommandsReceived;
+	TAtomic<int32> CommandsCompleted;
+	TAtomic<int32> CommandsRejected;
+	TAtomic<int32> InFlightCount;
+	TAtomic<int32> CompressedResponses;
+	TAtomic<int64> CompressionSavedBytes;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealEngineMCPTransport.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+class UUnrealEngineMCPBridge;
+class FMcpClientConnection;
+
+/**
+ * Owns all live client connections
+ * Accept loop hands new sockets here; finished connections are reaped periodically
+ */
+class FMcpConnectionManager
+{
+public:
+	FMcpConnectionManager(UUnrealEngineMCPBridge* InBridge, int32 InMaxConnections);
+	~FMcpConnectionManager();
+
+	// Takes ownership of an accepted socket. Returns false if the connection limit is reached.
+	bool AddConnection(TSharedPtr<FMcpStreamSocket> ClientSocket);
+
+	// Join and release connections whose thread has exited
+	void ReapFinishedConnections();
+
+	// Shut down every connection (called on server stop)
+	void CloseAll();
+
+	int32 GetConnectionCount() const;
+	int32 GetMaxConnections() const { return MaxConnections; }
+
+	// Stats for list_connections
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	UUnrealEngineMCPBridge* Bridge;
+	int32 MaxConnections;
+
+	TArray<TSharedPtr<FMcpClientConnection>> Connections;
+	mutable FCriticalSection ConnectionsLock;
+
+	uint32 NextConnectionId;
+	int32 TotalAccepted;
+	int32 TotalRejected;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+
+class FCborWriter;
+
+// Payload encoding, negotiated per connection on top of length-prefixed framing
+enum class EMcpEncoding : uint8
+{
+	Json,   // UTF-8 JSON text
+	Cbor    // CBOR (RFC 8949) with the same logical schema; maps and arrays use indefinite lengths
+};
+
+namespace McpEncoding
+{
+	const TCHAR* ToString(EMcpEncoding Encoding);
+	bool FromString(const FString& Name, EMcpEncoding& OutEncoding);
+
+	// Decode a CBOR request into the same DOM the JSON reader produces
+	bool ReadCborObject(TArrayView<const uint8> Data, TSharedPtr<FJsonObject>& OutObject);
+
+	// Opening of a response object with the client's serialized id as its first field.
+	// Replaces the first byte ('{' or the CBOR map header) of an encoded response body.
+	void AppendIdPrefix(EMcpEncoding Encoding, const FString& ClientId, TArray<uint8>& OutBytes);
+}
+
+/**
+ * Structured writer with a JSON and a CBOR backend
+ * Mirrors the TJsonWriter calls the streaming handlers use, so a handler is written once and
+ * emits whichever encoding the connection negotiated. With CBOR, numbers are written as binary
+ * integers/floats and never go through text formatting.
+ */
+class UNREALENGINEMCP_API FMcpValueWriter
+{
+public:
+	FMcpValueWriter(FArchive& Archive, EMcpEncoding InEncoding);
+	~FMcpValueWriter();
+
+	EMcpEncoding GetEncoding() const { return Encoding; }
+
+	void WriteObjectStart();
+	void WriteObjectStart(const FString& Name);
+	void WriteObjectEnd();
+
+	void WriteArrayStart();
+	void WriteArrayStart(const FString& Name);
+	void WriteArrayEnd();
+
+	// Object fields
+	void WriteValue(const FString& Name, const FString& Value);
+	void WriteValue(const FString& Name, const TCHAR* Value);
+	void WriteValue(const FString& Name, bool Value);
+	void WriteValue(const FString& Name, int32 Value);
+	void WriteValue(const FString& Name, int64 Value);
+	void WriteValue(const FString& Name, double Value);
+
+	// Array elements
+	void WriteValue(const FString& Value);
+	void WriteValue(bool Value);
+	void WriteValue(int32 Value);
+	void WriteValue(int64 Value);
+	void WriteValue(double Value);
+
+	// DOM values, as a named field or (with an empty Name) an array element / top-level value
+	void WriteJsonValue(const FString& Name, const TSharedPtr<FJsonValue>& Value);
+
+	void Close();
+
+private:
+	typedef TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>> FJsonWriterType;
+
+	void WriteCborNumber(double Value);
+	void WriteCborValue(const TSharedPtr<FJsonValue>& Value);
+
+	EMcpEncoding Encoding;
+	TSharedPtr<FJsonWriterType> JsonWriter;
+	TUniquePtr<FCborWriter> CborWriter;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/ObjectKey.h"
+#include "UnrealEngineMCPResponseWriter.h"
+
+class AActor;
+class UBlueprint;
+struct FAssetData;
+
+// Change notifications a connection can subscribe to
+enum class EMcpEventTopic : uint8
+{
+	None = 0,
+	Actors = 1 << 0,      // Editor-world actors added, removed, relabelled, moved
+	Assets = 1 << 1,      // Asset Registry assets added, removed, renamed
+	Blueprints = 1 << 2,  // Blueprints compiled
+	All = Actors | Assets | Blueprints
+};
+ENUM_CLASS_FLAGS(EMcpEventTopic)
+
+namespace McpEvents
+{
+	// "actors", "assets" or "blueprints"; false for an unknown name
+	bool ParseTopic(const FString& Name, EMcpEventTopic& OutTopic);
+	TArray<TSharedPtr<FJsonValue>> TopicNames(EMcpEventTopic Topics);
+}
+
+/**
+ * Editor changes pushed to subscribed connections
+ *
+ * Editor delegates are recorded on the game thread as they fire and coalesced per actor, asset
+ * or blueprint: an actor dragged over many frames is one "actor_moved", and one added and deleted
+ * within the same tick is nothing at all. Flush() runs once per editor tick and hands each
+ * subscriber one {"status":"event","seq":N,"events":[...]} frame through its FMcpResponseStream.
+ * The connection tags the frame with the id of the subscribe request. Nothing is recorded while
+ * nobody is subscribed.
+ */
+class FMcpEventHub
+{
+public:
+	FMcpEventHub();
+	~FMcpEventHub();
+
+	// Game thread: bind / unbind the editor delegates
+	void Start();
+	void Stop();
+
+	// Any thread. Events for Topics go to Stream, serialized in Encoding, until Unsubscribe or
+	// until the last reference to Stream is released.
+	void Subscribe(const FMcpResponseStreamPtr& Stream, EMcpEventTopic Topics, EMcpEncoding Encoding);
+	void Unsubscribe(const FMcpResponseStreamPtr& Stream);
+
+	int32 NumSubscribers() const { return SubscriberCount.Load(); }
+
+	// Game thread: send what was recorded since the last flush
+	void Flush();
+
+private:
+	enum EChange : uint8
+	{
+		Added = 1 << 0,
+		Removed = 1 << 1,
+		Renamed = 1 << 2,
+		Moved = 1 << 3
+	};
+
+	struct FActorChange
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FString Name;   // Captured when recorded: a removed actor cannot be asked later
+		FString Label;
+		uint8 Changes = 0;
+	};
+
+	struct FAssetChange
+	{
+		FString Class;
+		FString OldPath;  // Set for renames
+		uint8 Changes = 0;
+	};
+
+	struct FSubscriber
+	{
+		TWeakPtr<FMcpResponseStream, ESPMode::ThreadSafe> Stream;
+		EMcpEventTopic Topics;
+		EMcpEncoding Encoding;
+		int32 NextSeq;
+	};
+
+	// Delegate handlers (game thread)
+	void HandleActorAdded(AActor* Actor);
+	void HandleActorDeleted(AActor* Actor);
+	void HandleActorMoved(AActor* Actor);
+	void HandleActorLabelChanged(AActor* Actor);
+	void HandleAssetAdded(const FAssetData& AssetData);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+	void HandleBlueprintCompiled();
+
+	bool IsRecording() const { return SubscriberCount.Load() > 0; }
+	void RecordActor(AActor* Actor, EChange Change);
+	void RecordAsset(const FAssetData& AssetData, EChange Change);
+
+	// Turn the coalesced changes into event objects, grouped by topic
+	void BuildEvents(TArray<TSharedPtr<FJsonValue>>& OutActorEvents, TArray<TSharedPtr<FJsonValue>>& OutAssetEvents,
+		TArray<TSharedPtr<FJsonValue>>& OutBlueprintEvents);
+
+	// Pending changes (game thread only)
+	TMap<FObjectKey, FActorChange> ActorChanges;
+	TMap<FString, FAssetChange> AssetChanges;
+	TArray<TWeakObjectPtr<UBlueprint>> CompilingBlueprints;
+	TArray<TWeakObjectPtr<UBlueprint>> CompiledBlueprints;
+
+	TArray<FSubscriber> Subscribers;
+	mutable FCriticalSection SubscribersLock;
+	TAtomic<int32> SubscriberCount;
+
+	bool bStarted;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Wire framing for a connection. Newline is the default; LengthPrefixed is negotiated per connection.
+enum class EMcpFraming : uint8
+{
+	Newline,         // UTF-8 JSON terminated by '\n'
+	LengthPrefixed   // 4-byte big-endian payload length followed by the UTF-8 payload
+};
+
+// Response compression, negotiated per connection on top of length-prefixed framing
+enum class EMcpCompression : uint8
+{
+	None,
+	LZ4,
+	Zlib
+};
+
+enum class EMcpFrameResult : uint8
+{
+	Complete,
+	Incomplete,
+	TooLarge
+};
+
+namespace McpFraming
+{
+	static constexpr int32 LengthPrefixSize = 4;
+
+	// Set in the length prefix of a compressed frame. Its payload is the 4-byte big-endian
+	// uncompressed size followed by the codec output.
+	static constexpr uint32 CompressedFlag = 0x80000000u;
+
+	const TCHAR* ToString(EMcpFraming Framing);
+	bool FromString(const FString& Name, EMcpFraming& OutFraming);
+
+	const TCHAR* ToString(EMcpCompression Compression);
+	bool FromString(const FString& Name, EMcpCompression& OutCompression);
+
+	// Append Payload as one compressed length-prefixed frame. Returns false (and appends nothing)
+	// if the codec fails or the result would not be smaller.
+	bool AppendCompressedFrame(const uint8* Payload, int32 PayloadSize, EMcpCompression Compression, TArray<uint8>& OutBytes);
+
+	// Bytes before/after a payload of PayloadSize bytes, for payloads sent in several pieces
+	void AppendHeader(uint32 PayloadSize, EMcpFraming Framing, TArray<uint8>& OutBytes);
+	void AppendTrailer(EMcpFraming Framing, TArray<uint8>& OutBytes);
+}
+
+/**
+ * Byte receive buffer for one connection
+ * Socket data is received straight into the free tail and kept as UTF-8; complete frames are
+ * handed out as views into the buffer. Consumed space at the head is reclaimed by sliding the
+ * unread bytes down once it exceeds half the capacity, so steady-state traffic never reallocates.
+ */
+class FMcpReceiveBuffer
+{
+public:
+	explicit FMcpReceiveBuffer(int32 InitialCapacity);
+
+	// Writable region of at least MinFree bytes at the tail
+	uint8* PrepareWrite(int32 MinFree, int32& OutFree);
+	void CommitWrite(int32 BytesWritten);
+
+	// Locate the next complete frame. OutFrame stays valid until Consume or PrepareWrite.
+	EMcpFrameResult PeekFrame(EMcpFraming Framing, int32 MaxFrameSize, TArrayView<const uint8>& OutFrame, int32& OutConsumed);
+	void Consume(int32 NumBytes);
+
+	int32 Num() const { return Tail - Head; }
+
+private:
+	void Compact();
+
+	TArray<uint8> Data;
+	int32 Head;
+	int32 Tail;
+
+	// Bytes after Head already scanned for a newline, so partial lines are never rescanned
+	int32 ScanOffset;
+};
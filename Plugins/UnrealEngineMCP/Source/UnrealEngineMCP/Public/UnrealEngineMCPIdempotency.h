@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UnrealEngineMCPResponseWriter.h"
+
+/**
+ * Recent responses of requests sent with an "idempotency_key"
+ *
+ * Clients retry a command when the connection drops, which may happen after the editor already
+ * ran it. The bridge looks the key up right before executing a request and replays the stored
+ * response instead of running the command again. Game-thread commands execute one at a time, so a
+ * retry queued behind the original always finds its result. Bounded by entry count and age.
+ */
+class FMcpIdempotencyCache
+{
+public:
+	FMcpIdempotencyCache();
+
+	// Any thread. True if Key has a stored response; OutEncoding is the encoding it was stored in.
+	bool Find(const FString& Key, FMcpResponseBody& OutBody, EMcpEncoding& OutEncoding);
+
+	// Any thread. Responses above the size limit are not kept.
+	void Store(const FString& Key, const FMcpResponseBody& Body, EMcpEncoding Encoding);
+
+	void Reset();
+
+	int32 Num() const;
+	int32 GetReplayCount() const { return Replays.Load(); }
+
+private:
+	struct FEntry
+	{
+		FMcpResponseBody Body;
+		EMcpEncoding Encoding;
+		double StoredAt;
+	};
+
+	void EvictExpired(double Now);
+
+	TMap<FString, FEntry> Entries;
+	TArray<FString> InsertionOrder;  // Oldest first, for eviction
+	mutable FCriticalSection EntriesLock;
+	TAtomic<int32> Replays;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "UnrealEngineMCPResponseWriter.h"
+
+enum class EMcpJobState : uint8
+{
+	Queued,
+	Running,
+	Succeeded,
+	Failed,
+	Cancelled
+};
+
+/**
+ * One slice of a job's work, run on the game thread
+ * Returns the handler result object ({"success": ...}) once the work is finished, or null to be
+ * called again on a later tick. OutProgress (0..1) is reported by job_status.
+ */
+typedef TFunction<TSharedPtr<FJsonObject>(float& OutProgress)> FMcpJobSliceFunction;
+
+namespace McpJobs
+{
+	const TCHAR* ToString(EMcpJobState State);
+}
+
+/**
+ * Long-running commands submitted with "async": true
+ *
+ * Submitting returns a job id at once; the work then runs in slices on the game thread, one job
+ * at a time in submission order, sharing the editor tick budget with queued commands. Clients
+ * poll job_status (answered off the game thread, so it works while a slice is running) and can
+ * cancel_job between slices. Finished jobs are kept for a while so their result can be collected.
+ */
+class FMcpJobManager
+{
+public:
+	FMcpJobManager();
+
+	// Any thread. Empty id (and OutError set) when too many jobs are unfinished.
+	FString Submit(const FString& CommandType, FMcpJobSliceFunction&& Work, FString& OutError);
+
+	// Any thread. Null for an unknown or expired job id.
+	TSharedPtr<FJsonObject> GetStatus(const FString& JobId) const;
+	TSharedPtr<FJsonObject> ListJobs() const;
+	bool Cancel(const FString& JobId);
+
+	// Game thread: run job slices until EndTime (at least one slice if a job is waiting)
+	void Tick(double EndTime);
+
+	void Reset();
+
+private:
+	struct FJob
+	{
+		FString Id;
+		FString CommandType;
+		EMcpJobState State;
+		float Progress;
+		FMcpJobSliceFunction Work;
+		TSharedPtr<FJsonObject> Result;
+		FString Error;
+		FMcpCancellationToken Cancellation;
+		double SubmittedAt;
+		double StartedAt;
+		double FinishedAt;
+
+		FJob() : State(EMcpJobState::Queued), Progress(0.0f), SubmittedAt(0.0), StartedAt(0.0), FinishedAt(0.0) {}
+		bool IsFinished() const { return State == EMcpJobState::Succeeded || State == EMcpJobState::Failed || State == EMcpJobState::Cancelled; }
+	};
+
+	TSharedPtr<FJsonObject> ToJson(const FJob& Job, bool bIncludeResult) const;
+	void Finish(FJob& Job, EMcpJobState State);
+	void PruneFinished(double Now);
+
+	// Submission order; the first unfinished job is the one that runs
+	TArray<TSharedPtr<FJob>> Jobs;
+	mutable FCriticalSection JobsLock;
+	uint32 NextJobId;
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/UObjectGlobals.h"
+#include "UnrealEngineMCPResponseWriter.h"
+
+class AActor;
+class UBlueprint;
+struct FAssetData;
+
+/**
+ * Read-through cache for repeated editor queries
+ *
+ * Responses of cached queries (analyze_blueprint, get_class_functions, search_assets,
+ * list_gameplay_tags, ...) are kept under the command, its parameters with keys sorted, and the
+ * encoding. Each entry is stamped with the change epochs its command reads: a per-blueprint
+ * counter, the asset registry, the editor world's actors, reflection (bumped by hot reload and
+ * live coding) and the gameplay tag tree. Editor delegates bump the epochs as changes happen, so
+ * a hit never needs to look at the editor at all. Epochs are read before the command runs; a
+ * change that lands while it runs leaves a stale stamp and the next lookup misses.
+ *
+ * Errors, streamed and cancelled responses are never stored. Clients skip the cache for one
+ * request with "bypass_cache": true in its params.
+ */
+class FMcpResponseCache
+{
+public:
+	// Epoch values one entry was built against; epochs its command does not read stay zero
+	struct FStamp
+	{
+		uint32 Blueprint = 0;
+		uint32 BlueprintClasses = 0;
+		uint32 Assets = 0;
+		uint32 Actors = 0;
+		uint32 Reflection = 0;
+		uint32 Tags = 0;
+
+		bool operator==(const FStamp& Other) const
+		{
+			return Blueprint == Other.Blueprint && BlueprintClasses == Other.BlueprintClasses && Assets == Other.Assets
+				&& Actors == Other.Actors && Reflection == Other.Reflection && Tags == Other.Tags;
+		}
+	};
+
+	// What Store needs about a request that missed; invalid when the request is not cacheable
+	struct FTicket
+	{
+		FString Key;
+		FStamp Stamp;
+
+		bool IsValid() const { return !Key.IsEmpty(); }
+	};
+
+	FMcpResponseCache();
+	~FMcpResponseCache();
+
+	// Game thread: bind / unbind the editor delegates that bump the epochs
+	void Start();
+	void Stop();
+
+	void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+
+	// Commands whose responses may be cached
+	static bool IsCachedCommand(const FString& CommandType);
+
+	// Any thread. True with the stored response on a hit. On a miss OutTicket is filled in for
+	// Store when the response may be kept.
+	bool Find(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, EMcpEncoding Encoding, bool bStreamed,
+		FMcpResponseBody& OutBody, FTicket& OutTicket);
+
+	// Any thread. Responses above the size limit are not kept.
+	void Store(const FTicket& Ticket, const FMcpResponseBody& Body);
+
+	// Any thread. A command that is not read-only ran and may have changed what cached queries
+	// return; editor delegates do not see every change a handler makes.
+	void NoteCommandExecuted(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	void Reset();
+
+	TSharedPtr<FJsonObject> GetStatsJson() const;
+
+private:
+	struct FEntry
+	{
+		FMcpResponseBody Body;
+		FStamp Stamp;
+	};
+
+	FStamp MakeStamp(const FString& CommandType, const TSharedPtr<FJsonObject>& Params) const;
+	uint32 GetBlueprintEpoch(const FString& BlueprintName) const;
+	void BumpBlueprint(const FString& BlueprintName);
+	void BumpAll();
+	void RemoveOldest();
+
+	// Delegate handlers (game thread)
+	void HandleAssetChanged(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void HandleActorChanged(AActor* Actor);
+	void HandleMapChange(uint32 MapChangeFlags);
+	void HandleObjectModified(UObject* Object);
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+	void HandleBlueprintCompiled();
+	void HandleReloadComplete(EReloadCompleteReason Reason);
+	void HandleTagTreeChanged();
+	void HandleUndoRedo();
+
+	TAtomic<bool> bEnabled;
+
+	// Epochs
+	TAtomic<uint32> BlueprintClassesEpoch;
+	TAtomic<uint32> AssetsEpoch;
+	TAtomic<uint32> ActorsEpoch;
+	TAtomic<uint32> ReflectionEpoch;
+	TAtomic<uint32> TagsEpoch;
+	TMap<FName, uint32> BlueprintEpochs;  // Values come from NextBlueprintEpoch, so they never repeat
+	uint32 NextBlueprintEpoch;
+	uint32 BlueprintEpochFloor;           // Every blueprint counts as changed at this epoch (BumpAll)
+	mutable FCriticalSection BlueprintEpochsLock;
+
+	// Parameter values are compared exactly; FString keys ignore case by default
+	struct FCaseSensitiveKeyFuncs : TDefaultMapHashableKeyFuncs<FString, FEntry, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	TMap<FString, FEntry, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> Entries;
+	TArray<FString> InsertionOrder;  // Oldest first, for eviction
+	int64 TotalBytes;
+	mutable FCriticalSection EntriesLock;
+
+	TAtomic<int32> Hits;
+	TAtomic<int32> Misses;
+	TAtomic<int32> Stale;     // Misses that found an entry built against older epochs
+	TAtomic<int32> Bypassed;
+
+	bool bStarted;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle MapChangeHandle;
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle TagTreeChangedHandle;
+	FDelegateHandle UndoRedoHandle;
+};
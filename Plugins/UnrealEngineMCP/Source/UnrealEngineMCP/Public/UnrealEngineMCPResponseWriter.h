@@ -0,0 +1,278 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/Archive.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformTime.h"
+#include "UnrealEngineMCPEncoding.h"
+
+class FMcpCompletionSignal;
+
+/**
+ * Serialized response (UTF-8 JSON or CBOR), stored as fixed-size chunks
+ * Growing never reallocates or copies what was already written, and the network thread sends
+ * the chunks as they are instead of joining them into one contiguous string first.
+ */
+class UNREALENGINEMCP_API FMcpResponseBody
+{
+public:
+	static constexpr int32 ChunkSize = 64 * 1024;
+
+	FMcpResponseBody() : Size(0) {}
+
+	static FMcpResponseBody FromString(const FString& Json);
+
+	void Append(const uint8* Data, int64 Count);
+	void Reset();
+
+	int64 Num() const { return Size; }
+	bool IsEmpty() const { return Size == 0; }
+	const TArray<TArray<uint8>>& GetChunks() const { return Chunks; }
+
+	// Leading bytes decoded for log output
+	FString Preview(int32 MaxBytes) const;
+
+private:
+	TArray<TArray<uint8>> Chunks;
+	int64 Size;
+};
+
+/**
+ * Cancellation state shared by a connection and one of its requests
+ * The connection cancels on an explicit "cancel" message; once the request's deadline passes it
+ * counts as cancelled too. Abandoned means nobody will read the response any more (timeout,
+ * disconnect), so the bridge drops it instead of storing it. Handlers poll IsCancelled().
+ */
+class UNREALENGINEMCP_API FMcpCancellationToken
+{
+public:
+	explicit FMcpCancellationToken(double InDeadline = 0.0) : Deadline(InDeadline), bCancelled(false), bAbandoned(false) {}
+
+	void Cancel() { bCancelled = true; }
+	void Abandon() { bAbandoned = true; bCancelled = true; }
+
+	bool IsCancelled() const { return bCancelled || IsPastDeadline(); }
+	bool IsAbandoned() const { return bAbandoned; }
+	bool IsPastDeadline() const { return Deadline > 0.0 && FPlatformTime::Seconds() > Deadline; }
+
+	// FPlatformTime::Seconds() after which the request is cancelled; 0 for none
+	double GetDeadline() const { return Deadline; }
+
+private:
+	const double Deadline;
+	TAtomic<bool> bCancelled;
+	TAtomic<bool> bAbandoned;
+};
+
+typedef TSharedPtr<FMcpCancellationToken, ESPMode::ThreadSafe> FMcpCancellationTokenPtr;
+
+/**
+ * Partial results of one streamed request, handed from the game thread to the connection
+ * Requests sent with "stream": true get one of these. Handlers push chunk frames while they run
+ * and the connection's writer sends them immediately, ahead of the final response. Stopping
+ * early goes through the request's FMcpCancellationToken like any other request.
+ */
+class UNREALENGINEMCP_API FMcpResponseStream
+{
+public:
+	explicit FMcpResponseStream(const TSharedPtr<FMcpCompletionSignal, ESPMode::ThreadSafe>& InSignal);
+
+	// Game thread
+	void PushChunk(FMcpResponseBody&& Chunk);
+
+	// Connection writer - appends queued chunks in push order
+	bool PopChunks(TArray<FMcpResponseBody>& OutChunks);
+
+private:
+	TSharedPtr<FMcpCompletionSignal, ESPMode::ThreadSafe> Signal;
+	TArray<FMcpResponseBody> PendingChunks;
+	FCriticalSection ChunkLock;
+};
+
+typedef TSharedPtr<FMcpResponseStream, ESPMode::ThreadSafe> FMcpResponseStreamPtr;
+
+/**
+ * Completion slot for one request's final response
+ * Single producer, single consumer: the thread that ran the command fulfils it once and the
+ * connection that sent the request takes the body. Ownership of the body moves by atomic state
+ * change, so no lock is shared with other requests. Both sides hold a reference and whichever lets
+ * go last frees the body; a result still unclaimed after the bridge's TTL is expired.
+ */
+class UNREALENGINEMCP_API FMcpResponseSlot
+{
+public:
+	FMcpResponseSlot();
+	~FMcpResponseSlot();
+
+	// Producer, at most once: store the response / record that nobody wants it any more
+	void Fulfil(FMcpResponseBody&& InBody);
+	void Discard();
+
+	// Consumer: the producer is done with the slot (fulfilled, expired or discarded)
+	bool IsDone() const { return State.Load() != EState::Pending; }
+
+	// Consumer: move the response out; false when there is none to take
+	bool Take(FMcpResponseBody& OutBody);
+
+	// Sweeper: release the body if it was fulfilled before CutoffTime and is still unclaimed.
+	// True once the slot no longer needs watching (taken, expired or discarded).
+	bool ExpireIfOlderThan(double CutoffTime);
+
+	// Process-wide gauges
+	static int32 GetOutstandingCount() { return Outstanding.Load(); }  // Slots still referenced
+	static int32 GetUnclaimedCount() { return Unclaimed.Load(); }      // Fulfilled, not taken yet
+	static int32 GetExpiredCount() { return Expired.Load(); }          // Released after the TTL, since startup
+	static int32 GetDiscardedCount() { return Discarded.Load(); }      // Never stored because the requester had gone
+
+private:
+	enum class EState : uint8
+	{
+		Pending,
+		Ready,
+		Taken,
+		Expired,
+		Discarded
+	};
+
+	TAtomic<EState> State;
+	FMcpResponseBody Body;
+	double FulfilledAt;  // Written before State becomes Ready
+
+	static TAtomic<int32> Outstanding;
+	static TAtomic<int32> Unclaimed;
+	static TAtomic<int32> Expired;
+	static TAtomic<int32> Discarded;
+};
+
+typedef TSharedPtr<FMcpResponseSlot, ESPMode::ThreadSafe> FMcpResponseSlotPtr;
+typedef TWeakPtr<FMcpResponseSlot, ESPMode::ThreadSafe> FMcpResponseSlotWeakPtr;
+
+/**
+ * Streaming writer for command responses, in the encoding negotiated by the connection
+ *
+ * Handlers that produce large results write straight into the response body through Values()
+ * instead of building an FJsonObject DOM first:
+ *
+ *   Writer.BeginSuccess();
+ *   FMcpItemWriter Actors(Writer, TEXT("actors"));
+ *   ...
+ *   Actors.Finish();
+ *   Writer.EndSuccess();
+ *
+ * DOM results from the other handlers go through WriteResponse, which serializes the envelope
+ * into the same chunked body.
+ */
+class UNREALENGINEMCP_API FMcpResponseWriter
+{
+public:
+	explicit FMcpResponseWriter(const FMcpResponseStreamPtr& InStream = nullptr, EMcpEncoding InEncoding = EMcpEncoding::Json,
+		const FMcpCancellationTokenPtr& InCancellation = nullptr);
+
+	// {"status":"success","result":{ ... }}
+	void BeginSuccess();
+	void EndSuccess();
+
+	// Write a DOM value as a field of the currently open object
+	void WriteField(const FString& Name, const TSharedPtr<FJsonValue>& Value);
+
+	// Discards anything written so far and emits {"status":"error","error":Message}
+	void WriteError(const FString& Message);
+
+	// Serialize a complete envelope built as a DOM
+	void WriteResponse(const TSharedPtr<FJsonObject>& ResponseJson);
+
+	// Use an already serialized envelope (in this writer's encoding) as the response
+	void ReplaceBody(FMcpResponseBody&& InBody);
+
+	FMcpValueWriter& Values() { return *Writer; }
+	EMcpEncoding GetEncoding() const { return Encoding; }
+
+	// Set when the client asked for partial results
+	const FMcpResponseStreamPtr& GetStream() const { return Stream; }
+
+	// Long-running handlers check this between units of work and stop early once it is set
+	bool IsCancelled() const;
+
+	// The handler saw IsCancelled() return true, so the response may describe unfinished work
+	bool WasCancellationObserved() const { return bCancellationObserved; }
+
+	// The response is an error envelope
+	bool HasError() const { return bHasError; }
+
+	// Time spent in WriteResponse; streaming handlers serialize as they go and are not counted
+	double GetSerializeSeconds() const { return SerializeSeconds; }
+
+	int64 BodySize() const { return Body.Num(); }
+	const FMcpResponseBody& GetBody() const { return Body; }
+	FMcpResponseBody MoveBody() { return MoveTemp(Body); }
+
+private:
+	// Routes encoder output into the chunked body
+	class FBodyArchive : public FArchive
+	{
+	public:
+		explicit FBodyArchive(FMcpResponseBody& InBody) : Body(InBody) { SetIsSaving(true); }
+		virtual void Serialize(void* Data, int64 Num) override { Body.Append((const uint8*)Data, Num); }
+		virtual FString GetArchiveName() const override { return TEXT("FMcpResponseWriter"); }
+
+	private:
+		FMcpResponseBody& Body;
+	};
+
+	void ResetWriter();
+
+	FMcpResponseBody Body;
+	FBodyArchive Archive;
+	EMcpEncoding Encoding;
+	TUniquePtr<FMcpValueWriter> Writer;
+	FMcpResponseStreamPtr Stream;
+	FMcpCancellationTokenPtr Cancellation;
+	mutable bool bCancellationObserved;
+	bool bHasError;
+	double SerializeSeconds;
+};
+
+/**
+ * Writes a result array that is either inline or streamed, so handlers are written once
+ *
+ * Without a stream the items form the Field array inside the open result object. With a stream
+ * they are flushed as {"status":"partial","field":Field,"seq":N,"items":[...]} frames every
+ * 64 KB or 100 ms, and Finish() writes a "stream" summary into the result instead.
+ */
+class UNREALENGINEMCP_API FMcpItemWriter
+{
+public:
+	FMcpItemWriter(FMcpResponseWriter& InResponseWriter, const FString& InField);
+
+	// Open an object item, write its fields through the returned writer, then EndItem()
+	FMcpValueWriter& BeginItem();
+	void EndItem();
+
+	// Add a DOM item
+	void AddItem(const TSharedPtr<FJsonObject>& Item);
+
+	void Finish();
+
+	int32 Num() const { return ItemCount; }
+
+	// Handlers stop producing once the client has cancelled the stream or the request
+	bool IsCancelled() const;
+
+private:
+	void BeginChunk();
+	void FlushChunkIfDue();
+	void FlushChunk();
+
+	FMcpResponseWriter& ResponseWriter;
+	FString Field;
+	FMcpResponseStreamPtr Stream;
+
+	// Current partial frame (stream mode only)
+	TUniquePtr<FMcpResponseWriter> ChunkWriter;
+	int32 ChunkItemCount;
+	int32 ChunkCount;
+	double LastFlushTime;
+
+	int32 ItemCount;
+};
@@ -2,18 +2,19 @@
 
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
-#include "Sockets.h"
+#include "UnrealEngineMCPTransport.h"
 
 class UUnrealEngineMCPBridge;
+class FMcpConnectionManager;
 
 /**
  * Runnable class for the MCP server thread
- * Handles incoming socket connections from Python MCP Server
+ * Accepts incoming connections on one listener (TCP or local socket) and hands them to the connection manager
  */
 class FUnrealEngineMCPRunnable : public FRunnable
 {
 public:
-	FUnrealEngineMCPRunnable(UUnrealEngineMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket);
+	FUnrealEngineMCPRunnable(UUnrealEngineMCPBridge* InBridge, TSharedPtr<FMcpListener> InListener, TSharedPtr<FMcpConnectionManager> InConnectionManager);
 	virtual ~FUnrealEngineMCPRunnable();
 
 	// FRunnable interface
@@ -23,12 +24,11 @@ public:
 	virtual void Exit() override;
 
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	bool ProcessMessageBuffer(TSharedPtr<FSocket> ClientSocket, FString& MessageBuffer);
+	void AcceptPendingConnection();
 
 private:
 	UUnrealEngineMCPBridge* Bridge;
-	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
+	TSharedPtr<FMcpListener> Listener;
+	TSharedPtr<FMcpConnectionManager> ConnectionManager;
 	bool bRunning;
-};
\ No newline at end of file
+};
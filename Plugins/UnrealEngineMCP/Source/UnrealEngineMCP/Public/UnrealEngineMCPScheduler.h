@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMcpCommandRequest;
+
+// Scheduling class of a command, highest priority first
+enum class EMcpPriority : uint8
+{
+	Interactive,  // Single edits and cheap lookups an agent is waiting on
+	ReadOnly,     // Listing, searching and analysis
+	Bulk,         // Long-running work: asset creation, compiles, Python, region loading, batches
+	Count
+};
+
+// Where a command may execute
+enum class EMcpThreadAffinity : uint8
+{
+	GameThread,  // Touches the world, editors or objects that are not safe to read concurrently
+	AnyThread    // Only reads thread-safe state: Asset Registry, gameplay tags, native reflection, job table
+};
+
+namespace McpScheduling
+{
+	const TCHAR* ToString(EMcpPriority Priority);
+}
+
+/**
+ * Game-thread command lanes, one per priority
+ * Every connection has a single FIFO, so its requests always run in the order it sent them: a
+ * pipelined create_blueprint is never overtaken by the add_component_to_blueprint behind it. A
+ * connection waits in the lane of the request at the head of its FIFO, and each lane serves its
+ * connections round-robin, so one client flooding the bridge cannot starve the others. Lanes are
+ * served in priority order, except that a lower lane whose oldest head request has waited longer
+ * than the starvation limit goes first. Priority therefore orders different connections' work,
+ * never one connection's own requests. A connection whose head request cannot start yet (the caller's
+ * CanStart says no) is passed over without losing its place in the lane.
+ * Not thread-safe: requests arrive through the bridge's MPSC queue and are pushed here on the game thread.
+ */
+class FMcpCommandScheduler
+{
+public:
+	// Out of line: FMcpCommandRequest is only complete in the translation unit
+	FMcpCommandScheduler();
+	~FMcpCommandScheduler();
+
+	void Push(FMcpCommandRequest&& Request);
+
+	// Next request to run, or nullptr when every lane is empty or no head request can start.
+	// Valid until the next Push/Pop.
+	const FMcpCommandRequest* Peek(double Now, TFunctionRef<bool(const FMcpCommandRequest&)> CanStart);
+	void Pop(FMcpCommandRequest& OutRequest);
+
+	void Reset();
+
+	int32 Num() const { return NumQueued; }
+
+private:
+	struct FLane
+	{
+		TArray<uint32> ServiceOrder;  // Connections whose head request is in this lane, next to be served first
+	};
+
+	static int32 GetLaneIndex(const FMcpCommandRequest& Request);
+	const FMcpCommandRequest& GetHead(uint32 ConnectionId) const;
+
+	// Position in the lane's ServiceOrder of the first connection whose head can start, or INDEX_NONE
+	int32 FindStartable(int32 LaneIndex, TFunctionRef<bool(const FMcpCommandRequest&)> CanStart) const;
+
+	TMap<uint32, TArray<FMcpCommandRequest>> PerConnection;  // Submission order
+	FLane Lanes[(int32)EMcpPriority::Count];
+	int32 NumQueued;
+	int32 SelectedLane;
+	int32 SelectedEntry;  // Into the selected lane's ServiceOrder
+	double StarvationSeconds;
+};
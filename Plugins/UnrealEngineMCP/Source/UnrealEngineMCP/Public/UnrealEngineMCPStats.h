@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+struct FMcpCommandInfo;
+
+// Where a request's time goes, in the order it happens
+enum class EMcpLatencyPhase : uint8
+{
+	Queue,      // Received until a thread started executing it
+	Execute,    // Handler, not counting DOM serialization
+	Serialize,  // DOM result written into the response body
+	Send,       // Final response written to the socket
+	Total,      // Received until the final response was sent
+	Count
+};
+
+/**
+ * Log-bucketed histogram of non-negative integer values (HdrHistogram style)
+ * Values below 32 are counted exactly. Above that each power of two is split into 32 buckets, so
+ * a reported percentile is within 1/64 of the true value at any magnitude, in constant memory.
+ * Buckets are only allocated once the first value is recorded. Not thread-safe.
+ */
+class FMcpHistogram
+{
+public:
+	FMcpHistogram();
+
+	void Record(uint64 Value);
+	void Reset();
+
+	int64 GetCount() const { return Count; }
+
+	// Percentile in [0, 1]; 0 when nothing was recorded
+	uint64 GetPercentile(double Percentile) const;
+
+	// {"count", "min", "mean", "p50", "p90", "p99", "p999", "max"}, values multiplied by Scale
+	TSharedPtr<FJsonObject> ToJson(double Scale = 1.0) const;
+
+private:
+	static int32 GetBucketIndex(uint64 Value);
+	static uint64 GetBucketMidpoint(int32 Index);
+
+	TArray<uint32> Buckets;
+	int64 Count;
+	uint64 Min;
+	uint64 Max;
+	double Sum;
+};
+
+/**
+ * Per-command latency histograms and server counters, for "get_server_stats"
+ *
+ * Latencies are recorded in microseconds for each EMcpLatencyPhase, per registered command;
+ * names that are not in the registry all count as "unknown", so clients cannot grow the table. The bridge
+ * records queue wait, execution and serialization when a request runs, on whichever thread runs
+ * it; connections record the socket send and the total once the final response is out. Counters
+ * cover requests, errors, replayed responses, requests rejected because the queue was full,
+ * queue depth at enqueue time and bytes in/out. Everything accumulates until Reset.
+ */
+class FMcpServerStats
+{
+public:
+	FMcpServerStats();
+
+	// Any thread. A request frame of RequestBytes arrived for Command (null when unknown).
+	void RecordReceived(const FMcpCommandInfo* Command, int64 RequestBytes);
+
+	// Any thread. Depth counts the request that was just enqueued.
+	void RecordEnqueued(int32 Depth);
+	void RecordRejected(const FMcpCommandInfo* Command);
+
+	// Any thread. bExecuted is false when a stored or cached response was replayed instead.
+	void RecordExecution(const FMcpCommandInfo* Command, double QueueSeconds, double ExecuteSeconds, double SerializeSeconds,
+		bool bExecuted, bool bError);
+
+	// Connection writer. Partial frames only add bytes; the final frame also adds send and total time.
+	void RecordResponseBytes(const FMcpCommandInfo* Command, int64 ResponseBytes);
+	void RecordDelivery(const FMcpCommandInfo* Command, int64 ResponseBytes, double SendSeconds, double TotalSeconds);
+
+	// Raw socket traffic of every connection, including connection-level messages
+	void AddBytesReceived(int64 Bytes) { BytesReceived += Bytes; }
+	void AddBytesSent(int64 Bytes) { BytesSent += Bytes; }
+
+	// CommandFilter limits "commands" to one command type when not empty
+	TSharedPtr<FJsonObject> ToJson(const FString& CommandFilter = FString()) const;
+
+	void Reset();
+
+private:
+	struct FCommandStats
+	{
+		FMcpHistogram Latency[(int32)EMcpLatencyPhase::Count];
+		int64 Requests = 0;
+		int64 Errors = 0;
+		int64 Replayed = 0;
+		int64 Rejected = 0;
+		int64 BytesIn = 0;
+		int64 BytesOut = 0;
+	};
+
+	static uint64 ToMicroseconds(double Seconds);
+
+	// Caller holds StatsLock
+	FCommandStats& FindOrAddCommand(const FMcpCommandInfo* Command);
+
+	TMap<FName, FCommandStats> Commands;
+	FMcpHistogram QueueDepth;
+	int32 PeakQueueDepth;
+	int64 Rejected;
+	double ResetTime;
+	mutable FCriticalSection StatsLock;
+
+	TAtomic<int64> BytesReceived;
+	TAtomic<int64> BytesSent;
+};
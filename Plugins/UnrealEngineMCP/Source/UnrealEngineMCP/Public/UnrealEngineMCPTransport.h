@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sockets.h"
+#include "SocketTypes.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+
+// Unix domain sockets are available to the editor on Linux and macOS
+#define MCP_WITH_LOCAL_SOCKET (PLATFORM_UNIX || PLATFORM_MAC)
+
+/**
+ * Accepted client stream, either loopback TCP or a local (Unix domain) socket
+ * Same non-blocking semantics as FSocket: Recv returns true with 0 bytes once the peer has closed,
+ * and a failed Recv/Send reports SE_EWOULDBLOCK when it should simply be retried.
+ */
+class FMcpStreamSocket
+{
+public:
+	virtual ~FMcpStreamSocket() {}
+
+	virtual bool Wait(ESocketWaitConditions::Type Condition, FTimespan WaitTime) = 0;
+	virtual bool Recv(uint8* Data, int32 BufferSize, int32& BytesRead) = 0;
+	virtual bool Send(const uint8* Data, int32 Count, int32& BytesSent) = 0;
+
+	// Error of the last failed Recv/Send, read on the thread that made the call
+	virtual ESocketErrors GetLastError() const = 0;
+
+	virtual void Close() = 0;
+
+	virtual FString GetRemoteAddress() const = 0;
+	virtual const TCHAR* GetTransportName() const = 0;
+};
+
+/** Listening endpoint handing out accepted FMcpStreamSocket connections */
+class FMcpListener
+{
+public:
+	virtual ~FMcpListener() {}
+
+	// Block up to WaitTime; true if Accept() will not block
+	virtual bool WaitForPendingConnection(FTimespan WaitTime) = 0;
+	virtual TSharedPtr<FMcpStreamSocket> Accept() = 0;
+
+	virtual FString Describe() const = 0;
+};
+
+namespace McpTransport
+{
+	TSharedPtr<FMcpListener> CreateTcpListener(const FIPv4Address& Address, uint16 Port, int32 Backlog);
+
+	// Returns nullptr where local sockets are unsupported or the path cannot be bound.
+	// The socket file is created owner-only and removed when the listener is destroyed.
+	TSharedPtr<FMcpListener> CreateLocalListener(const FString& Path, int32 Backlog);
+
+	// Path clients look for when they connect to the default port on the same machine
+	FString GetDefaultLocalSocketPath(uint16 Port);
+}
@@ -41,6 +41,7 @@ public class UnrealEngineMCP : ModuleRules
 				"BlueprintGraph",
 				"Projects",
 				"AssetRegistry",
+				"Cbor",
 				"PropertyEditor",
 				"ToolMenus",
 				"BlueprintEditorLibrary",
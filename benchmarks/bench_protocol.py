@@ -0,0 +1,281 @@
+"""
+Protocol benchmark - measures bridge latency and idle cost against a running editor.
+
+Talks to the plugin over raw sockets so results reflect the server, not the client wrapper.
+Run the same scenario on the old and new plugin build to compare.
+
+Usage:
+    python benchmarks/bench_protocol.py latency --count 500
+    python benchmarks/bench_protocol.py pipelined --count 500
+    python benchmarks/bench_protocol.py large-payload --size-mb 4 --count 20
+    python benchmarks/bench_protocol.py compression --command list_level_actors --count 50
+    python benchmarks/bench_protocol.py idle-cpu --pid <UnrealEditor pid> --connections 4 --seconds 30
+
+Pass --socket-path /tmp/unreal-mcp-55557.sock before the scenario to run it over the
+plugin's Unix domain socket instead of TCP.
+"""
+import argparse
+import json
+import os
+import socket
+import statistics
+import struct
+import sys
+import time
+import zlib
+from typing import List
+
+DEFAULT_HOST = os.getenv("UNREAL_HOST", "127.0.0.1")
+DEFAULT_PORT = int(os.getenv("UNREAL_PORT", "55557"))
+
+
+def connect(args) -> socket.socket:
+    if args.socket_path:
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        sock.settimeout(60)
+        sock.connect(args.socket_path)
+        return sock
+    sock = socket.create_connection((args.host, args.port), timeout=60)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return sock
+
+
+def read_line(sock: socket.socket, buffer: bytearray) -> bytes:
+    while b'\n' not in buffer:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise ConnectionResetError("Connection closed")
+        buffer.extend(chunk)
+    index = buffer.index(b'\n')
+    line = bytes(buffer[:index])
+    del buffer[:index + 1]
+    return line
+
+
+def percentile(samples: List[float], pct: float) -> float:
+    ordered = sorted(samples)
+    index = min(len(ordered) - 1, max(0, int(round(pct / 100.0 * (len(ordered) - 1)))))
+    return ordered[index]
+
+
+def report(name: str, samples_ms: List[float], wall_s: float):
+    print(f"{name}: n={len(samples_ms)} wall={wall_s:.3f}s throughput={len(samples_ms) / wall_s:.1f} cmd/s")
+    print(f"  mean={statistics.mean(samples_ms):.3f}ms p50={percentile(samples_ms, 50):.3f}ms "
+          f"p90={percentile(samples_ms, 90):.3f}ms p99={percentile(samples_ms, 99):.3f}ms "
+          f"max={max(samples_ms):.3f}ms")
+
+
+def bench_latency(args):
+    """Sequential round trips on one connection (legacy untagged requests)."""
+    sock = connect(args)
+    buffer = bytearray()
+    message = (json.dumps({"type": args.command, "params": {}}) + "\n").encode('utf-8')
+    samples = []
+
+    start = time.perf_counter()
+    for _ in range(args.count):
+        t0 = time.perf_counter()
+        sock.sendall(message)
+        read_line(sock, buffer)
+        samples.append((time.perf_counter() - t0) * 1000.0)
+    wall = time.perf_counter() - start
+
+    sock.close()
+    report(f"sequential '{args.command}'", samples, wall)
+
+
+def bench_pipelined(args):
+    """All requests sent back-to-back with ids; per-request latency measured to its tagged response."""
+    sock = connect(args)
+    buffer = bytearray()
+    sent_at = {}
+    samples = []
+
+    start = time.perf_counter()
+    for request_id in range(1, args.count + 1):
+        sent_at[request_id] = time.perf_counter()
+        sock.sendall((json.dumps({"id": request_id, "type": args.command, "params": {}}) + "\n").encode('utf-8'))
+
+    while len(samples) < args.count:
+        response = json.loads(read_line(sock, buffer))
+        request_id = response.get("id")
+        if request_id in sent_at:
+            samples.append((time.perf_counter() - sent_at.pop(request_id)) * 1000.0)
+    wall = time.perf_counter() - start
+
+    sock.close()
+    report(f"pipelined '{args.command}'", samples, wall)
+
+
+def build_graph_payload(size_bytes: int) -> dict:
+    """Graph-shaped params (nodes with pins and non-ASCII names) of roughly size_bytes once encoded."""
+    nodes = []
+    encoded = 0
+    while encoded < size_bytes:
+        index = len(nodes)
+        node = {
+            "id": f"node_{index}",
+            "class": "K2Node_CallFunction",
+            "title": f"노드 {index} – Función",
+            "position": [index * 16.0, index * -8.5],
+            "pins": [{"name": f"pin_{pin}", "type": "float", "default": pin * 0.25} for pin in range(6)],
+        }
+        encoded += len(json.dumps(node).encode('utf-8')) + 1
+        nodes.append(node)
+    return {"graph_name": "BenchGraph", "nodes": nodes}
+
+
+def bench_large_payload(args):
+    """Round trips carrying a large request body; server time is dominated by request parsing."""
+    sock = connect(args)
+    buffer = bytearray()
+    params = build_graph_payload(int(args.size_mb * 1024 * 1024))
+    message = (json.dumps({"id": 1, "type": args.command, "params": params}) + "\n").encode('utf-8')
+    samples = []
+
+    start = time.perf_counter()
+    for _ in range(args.count):
+        t0 = time.perf_counter()
+        sock.sendall(message)
+        read_line(sock, buffer)
+        samples.append((time.perf_counter() - t0) * 1000.0)
+    wall = time.perf_counter() - start
+
+    sock.close()
+    mb_per_s = len(message) * args.count / wall / (1024 * 1024)
+    report(f"large-payload '{args.command}' {len(message) / (1024 * 1024):.2f}MB ({mb_per_s:.1f} MB/s)", samples, wall)
+
+
+def read_frame(sock: socket.socket, buffer: bytearray, size: int) -> bytes:
+    while len(buffer) < size:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise ConnectionResetError("Connection closed")
+        buffer.extend(chunk)
+    frame = bytes(buffer[:size])
+    del buffer[:size]
+    return frame
+
+
+def bench_compression(args):
+    """Negotiated response compression: wire bytes, round trip and client decode cost per codec."""
+    decoders = {"none": None, "zlib": lambda data, size: zlib.decompress(data)}
+    try:
+        import lz4.block
+        decoders["lz4"] = lambda data, size: lz4.block.decompress(data, uncompressed_size=size)
+    except ImportError:
+        print("lz4 not installed (pip install lz4) - skipping lz4", file=sys.stderr)
+
+    params = json.loads(args.params)
+    for codec, decode in decoders.items():
+        sock = connect(args)
+        buffer = bytearray()
+
+        negotiate = {"framing": "length_prefixed", "compression_threshold": args.threshold}
+        if decode is not None:
+            negotiate["compression"] = [codec]
+        sock.sendall((json.dumps({"id": 0, "type": "negotiate", "params": negotiate}) + "\n").encode('utf-8'))
+        result = json.loads(read_line(sock, buffer)).get("result", {})
+        if result.get("compression", "none") != codec:
+            print(f"compression '{codec}': declined by server ({result})")
+            sock.close()
+            continue
+
+        message = json.dumps({"id": 1, "type": args.command, "params": params}).encode('utf-8')
+        message = struct.pack('>I', len(message)) + message
+        samples = []
+        wire_bytes = raw_bytes = 0
+        decode_s = 0.0
+
+        start = time.perf_counter()
+        for _ in range(args.count):
+            t0 = time.perf_counter()
+            sock.sendall(message)
+            (length,) = struct.unpack('>I', read_frame(sock, buffer, 4))
+            payload = read_frame(sock, buffer, length & 0x7FFFFFFF)
+            d0 = time.perf_counter()
+            if length & 0x80000000:
+                (size,) = struct.unpack_from('>I', payload)
+                payload = decode(payload[4:], size)
+            json.loads(payload)
+            decode_s += time.perf_counter() - d0
+            samples.append((time.perf_counter() - t0) * 1000.0)
+            wire_bytes += 4 + (length & 0x7FFFFFFF)
+            raw_bytes += len(payload)
+        wall = time.perf_counter() - start
+
+        sock.close()
+        report(f"compression '{codec}' '{args.command}' wire={wire_bytes / args.count / 1024:.1f}KB "
+               f"raw={raw_bytes / args.count / 1024:.1f}KB ratio={raw_bytes / max(1, wire_bytes):.2f} "
+               f"client-decode={decode_s * 1000.0 / args.count:.3f}ms", samples, wall)
+
+
+def bench_idle_cpu(args):
+    """Editor CPU while MCP connections are open but idle."""
+    try:
+        import psutil
+    except ImportError:
+        print("idle-cpu requires psutil (pip install psutil)", file=sys.stderr)
+        sys.exit(1)
+
+    process = psutil.Process(args.pid)
+    sockets = [connect(args) for _ in range(args.connections)]
+
+    # Let accept/handler setup settle before sampling
+    time.sleep(1.0)
+    process.cpu_percent(None)
+    cpu_start = process.cpu_times()
+    time.sleep(args.seconds)
+    cpu_end = process.cpu_times()
+    average = process.cpu_percent(None)
+
+    for sock in sockets:
+        sock.close()
+
+    busy = (cpu_end.user - cpu_start.user) + (cpu_end.system - cpu_start.system)
+    print(f"idle-cpu: connections={args.connections} seconds={args.seconds} "
+          f"cpu_time={busy:.3f}s average={average:.1f}%")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default=DEFAULT_HOST)
+    parser.add_argument("--port", type=int, default=DEFAULT_PORT)
+    parser.add_argument("--socket-path", default=None, help="Connect over this Unix domain socket instead of TCP")
+    sub = parser.add_subparsers(dest="scenario", required=True)
+
+    latency = sub.add_parser("latency")
+    latency.add_argument("--count", type=int, default=500)
+    latency.add_argument("--command", default="ping")
+    latency.set_defaults(func=bench_latency)
+
+    pipelined = sub.add_parser("pipelined")
+    pipelined.add_argument("--count", type=int, default=500)
+    pipelined.add_argument("--command", default="ping")
+    pipelined.set_defaults(func=bench_pipelined)
+
+    large = sub.add_parser("large-payload")
+    large.add_argument("--size-mb", type=float, default=4.0)
+    large.add_argument("--count", type=int, default=20)
+    large.add_argument("--command", default="ping")
+    large.set_defaults(func=bench_large_payload)
+
+    compression = sub.add_parser("compression")
+    compression.add_argument("--count", type=int, default=50)
+    compression.add_argument("--command", default="list_level_actors")
+    compression.add_argument("--params", default="{}", help="JSON params for the command")
+    compression.add_argument("--threshold", type=int, default=16384)
+    compression.set_defaults(func=bench_compression)
+
+    idle = sub.add_parser("idle-cpu")
+    idle.add_argument("--pid", type=int, required=True)
+    idle.add_argument("--connections", type=int, default=4)
+    idle.add_argument("--seconds", type=float, default=30.0)
+    idle.set_defaults(func=bench_idle_cpu)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
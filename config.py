@@ -40,8 +40,16 @@ DATA_DIR.mkdir(parents=True, exist_ok=True)
 # Unreal Engine Connection
 UNREAL_HOST = os.getenv("UNREAL_HOST", "127.0.0.1")
 UNREAL_PORT = _get_int_env("UNREAL_PORT", 55557)
+UNREAL_TRANSPORT = os.getenv("UNREAL_TRANSPORT", "auto")  # auto | tcp | unix
+UNREAL_SOCKET_PATH = os.getenv("UNREAL_SOCKET_PATH", "")  # empty = /tmp/unreal-mcp-<port>.sock
 SOCKET_TIMEOUT = _get_int_env("SOCKET_TIMEOUT", 60)
 PYTHON_EXEC_TIMEOUT = _get_int_env("PYTHON_EXEC_TIMEOUT", 60)
+UNREAL_POOL_SIZE = _get_int_env("UNREAL_POOL_SIZE", 2)
+UNREAL_IDLE_CHECK_SECONDS = _get_int_env("UNREAL_IDLE_CHECK_SECONDS", 30)
+UNREAL_FRAMING = os.getenv("UNREAL_FRAMING", "length_prefixed")
+UNREAL_ENCODING = os.getenv("UNREAL_ENCODING", "json")
+UNREAL_COMPRESSION = os.getenv("UNREAL_COMPRESSION", "lz4,zlib")
+UNREAL_COMPRESSION_THRESHOLD = _get_int_env("UNREAL_COMPRESSION_THRESHOLD", 16384)
 
 # RAG Settings
 RAG_TOP_K = _get_int_env("RAG_TOP_K", 5)